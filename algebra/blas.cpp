@@ -0,0 +1,363 @@
+// implementation for blas.h
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "utils/array1d.h"
+#include "utils/array2d.h"
+#include "utils/parallel_for.h"
+
+namespace AMSTeL
+{
+  template <class MATRIX>
+  struct is_column_major_array : std::false_type {};
+
+  template <class C>
+  struct is_column_major_array<Array2D<C,ColumnMajor> > : std::true_type {};
+
+  // pointer to the storage of x if its entries are stored contiguously,
+  // a null pointer otherwise
+  template <class VECTOR>
+  inline
+  auto contiguous_storage(VECTOR& x) -> decltype(&x[0])
+  {
+    if constexpr (requires { x.stride(); x.data(); })
+      return x.stride() == 1 ? x.data() : nullptr;
+    else if constexpr (requires { x.aligned_data(); })
+      return x.aligned_data();
+    else
+      return nullptr;
+  }
+
+  // pointer to the storage of A if it is stored column by column with
+  // leading dimension ld, a null pointer otherwise
+  template <class MATRIX>
+  inline
+  auto column_major_storage(MATRIX& A, size_t& ld) -> decltype(&A(0,0))
+  {
+    if constexpr (requires { A.row_stride(); A.column_stride(); A.data(); })
+      {
+        ld = A.column_stride();
+        return A.row_stride() == 1 ? A.data() : nullptr;
+      }
+    else if constexpr (is_column_major_array<std::remove_const_t<MATRIX> >::value)
+      {
+        ld = A.leading_dimension();
+        return A.aligned_data();
+      }
+    else
+      return nullptr;
+  }
+
+  template <class C>
+  inline
+  C dot_kernel(const size_t n, const C* x, const C* y)
+  {
+    // independent partial sums hide the latency of the additions
+    C s0(0), s1(0), s2(0), s3(0);
+    size_t i(0);
+    for (; i+4 <= n; i += 4)
+      {
+        s0 += x[i]*y[i];
+        s1 += x[i+1]*y[i+1];
+        s2 += x[i+2]*y[i+2];
+        s3 += x[i+3]*y[i+3];
+      }
+    for (; i < n; i++)
+      s0 += x[i]*y[i];
+    return (s0+s1)+(s2+s3);
+  }
+
+  // y[0,m) += alpha*A*x for a column-major m x n matrix A
+  template <class C>
+  void gemv_kernel(const size_t m, const size_t n, const C alpha,
+                   const C* A, const size_t lda, const C* x, C* y)
+  {
+    // four columns at a time, so that y is loaded and stored n/4 times only
+    size_t j(0);
+    for (; j+4 <= n; j += 4)
+      {
+        const C t0(alpha*x[j]), t1(alpha*x[j+1]), t2(alpha*x[j+2]), t3(alpha*x[j+3]);
+        const C* a0(A+j*lda);
+        const C* a1(a0+lda);
+        const C* a2(a1+lda);
+        const C* a3(a2+lda);
+        for (size_t i(0); i < m; i++)
+          y[i] += t0*a0[i] + t1*a1[i] + t2*a2[i] + t3*a3[i];
+      }
+    for (; j < n; j++)
+      {
+        const C t(alpha*x[j]);
+        const C* a(A+j*lda);
+        for (size_t i(0); i < m; i++)
+          y[i] += t*a[i];
+      }
+  }
+
+  // D += alpha*A*B for an MR x kc block A and a kc x NR block B,
+  // the MR x NR block of D is accumulated in registers
+  template <class C, unsigned int MR, unsigned int NR>
+  void gemm_micro_kernel(const size_t kc, const C alpha,
+                         const C* A, const size_t lda,
+                         const C* B, const size_t ldb,
+                         C* D, const size_t ldd)
+  {
+    C acc[NR][MR] = {};
+    for (size_t p(0); p < kc; p++)
+      {
+        const C* a(A+p*lda);
+        for (unsigned int jj(0); jj < NR; jj++)
+          {
+            const C b(B[p+jj*ldb]);
+            for (unsigned int ii(0); ii < MR; ii++)
+              acc[jj][ii] += a[ii]*b;
+          }
+      }
+    for (unsigned int jj(0); jj < NR; jj++)
+      for (unsigned int ii(0); ii < MR; ii++)
+        D[ii+jj*ldd] += alpha*acc[jj][ii];
+  }
+
+  // the same for the fringes of size mr x nr
+  template <class C>
+  void gemm_fringe_kernel(const size_t mr, const size_t nr, const size_t kc, const C alpha,
+                          const C* A, const size_t lda,
+                          const C* B, const size_t ldb,
+                          C* D, const size_t ldd)
+  {
+    for (size_t jj(0); jj < nr; jj++)
+      for (size_t p(0); p < kc; p++)
+        {
+          const C t(alpha*B[p+jj*ldb]);
+          const C* a(A+p*lda);
+          C* d(D+jj*ldd);
+          for (size_t ii(0); ii < mr; ii++)
+            d[ii] += t*a[ii];
+        }
+  }
+
+  // D(:,[j0,j1)) = alpha*A*B(:,[j0,j1)) + beta*D(:,[j0,j1)) for column-major matrices
+  template <class C>
+  void gemm_kernel(const size_t m, const size_t k, const size_t j0, const size_t j1,
+                   const C alpha, const C* A, const size_t lda,
+                   const C* B, const size_t ldb,
+                   const C beta, C* D, const size_t ldd)
+  {
+    for (size_t j(j0); j < j1; j++)
+      {
+        C* d(D+j*ldd);
+        if (beta == C(0))
+          std::fill(d, d+m, C(0));
+        else if (beta != C(1))
+          for (size_t i(0); i < m; i++)
+            d[i] *= beta;
+      }
+    if (alpha == C(0))
+      return;
+
+    // register block MR x NR, cache blocks MC x KC of A (L2) and KC x NR of B (L1)
+    const unsigned int MR(8), NR(4);
+    const size_t MC(64), KC(256);
+    for (size_t pc(0); pc < k; pc += KC)
+      {
+        const size_t kc(std::min(KC, k-pc));
+        for (size_t ic(0); ic < m; ic += MC)
+          {
+            const size_t ie(std::min(ic+MC, m));
+            for (size_t j(j0); j < j1; j += NR)
+              {
+                const size_t nr(std::min(size_t(NR), j1-j));
+                for (size_t i(ic); i < ie; i += MR)
+                  {
+                    const size_t mr(std::min(size_t(MR), ie-i));
+                    const C* a(A+i+pc*lda);
+                    const C* b(B+pc+j*ldb);
+                    C* d(D+i+j*ldd);
+                    if (mr == MR && nr == NR)
+                      gemm_micro_kernel<C,MR,NR>(kc, alpha, a, lda, b, ldb, d, ldd);
+                    else
+                      gemm_fringe_kernel(mr, nr, kc, alpha, a, lda, b, ldb, d, ldd);
+                  }
+              }
+          }
+      }
+  }
+
+  template <class C, class VECTOR1, class VECTOR2>
+  void axpy(const C alpha, const VECTOR1& x, VECTOR2& y)
+  {
+    typedef typename VECTOR2::value_type value_type;
+    assert(x.size() == y.size());
+    const size_t n(y.size());
+    if (n == 0)
+      return;
+
+    const auto px(contiguous_storage(x));
+    const auto py(contiguous_storage(y));
+    if constexpr (std::is_same_v<typename VECTOR1::value_type, value_type>)
+      if (px != nullptr && py != nullptr)
+        {
+          const value_type a(alpha);
+          parallel_for(0, n, [=](const size_t begin, const size_t end, const unsigned int)
+                       {
+                         for (size_t i(begin); i < end; i++)
+                           py[i] += a*px[i];
+                       }, size_t(1)<<16);
+          return;
+        }
+
+    for (size_t i(0); i < n; i++)
+      y[i] += alpha*x[i];
+  }
+
+  template <class VECTOR1, class VECTOR2>
+  typename VECTOR1::value_type dot(const VECTOR1& x, const VECTOR2& y)
+  {
+    typedef typename VECTOR1::value_type value_type;
+    assert(x.size() == y.size());
+    const size_t n(x.size());
+    if (n == 0)
+      return value_type(0);
+
+    const auto px(contiguous_storage(x));
+    const auto py(contiguous_storage(y));
+    if constexpr (std::is_same_v<typename VECTOR2::value_type, value_type>)
+      if (px != nullptr && py != nullptr)
+        {
+          // the partial sums are added in chunk order, so that the result
+          // does not depend on the thread scheduling
+          const size_t grain(size_t(1)<<16);
+          std::vector<value_type> sums(parallel_chunks(0, n, grain), value_type(0));
+          parallel_for(0, n, [=,&sums](const size_t begin, const size_t end, const unsigned int chunk)
+                       {
+                         sums[chunk] = dot_kernel(end-begin, px+begin, py+begin);
+                       }, grain);
+          value_type r(0);
+          for (unsigned int chunk(0); chunk < sums.size(); chunk++)
+            r += sums[chunk];
+          return r;
+        }
+
+    value_type r(0);
+    for (size_t i(0); i < n; i++)
+      r += x[i]*y[i];
+    return r;
+  }
+
+  template <class VECTOR>
+  typename VECTOR::value_type nrm2(const VECTOR& x)
+  {
+    typedef typename VECTOR::value_type value_type;
+    const value_type s(dot(x, x));
+    if (std::isfinite(s) && s >= std::numeric_limits<value_type>::min())
+      return std::sqrt(s);
+
+    // the sum of squares over- or underflowed, rescale by the largest entry
+    value_type scale(0);
+    for (size_t i(0); i < x.size(); i++)
+      scale = std::max(scale, value_type(std::fabs(x[i])));
+    if (scale == value_type(0) || !std::isfinite(scale))
+      return scale;
+    value_type ssq(0);
+    for (size_t i(0); i < x.size(); i++)
+      {
+        const value_type t(x[i]/scale);
+        ssq += t*t;
+      }
+    return scale*std::sqrt(ssq);
+  }
+
+  template <class C, class MATRIX, class VECTOR1, class VECTOR2>
+  void gemv(const C alpha, const MATRIX& A, const VECTOR1& x,
+            const C beta, VECTOR2& y)
+  {
+    typedef typename VECTOR2::value_type value_type;
+    assert(A.column_dimension() == x.size());
+    assert(A.row_dimension() == y.size());
+    const size_t m(A.row_dimension()), n(A.column_dimension());
+    if (m == 0)
+      return;
+
+    size_t lda(0);
+    const auto pA(column_major_storage(A, lda));
+    const auto px(contiguous_storage(x));
+    const auto py(contiguous_storage(y));
+    if constexpr (std::is_same_v<typename MATRIX::value_type, value_type>
+                  && std::is_same_v<typename VECTOR1::value_type, value_type>)
+      if (pA != nullptr && px != nullptr && py != nullptr)
+        {
+          // each thread works on its own block of rows
+          const value_type a(alpha), b(beta);
+          parallel_for(0, m, [=](const size_t begin, const size_t end, const unsigned int)
+                       {
+                         if (b == value_type(0))
+                           std::fill(py+begin, py+end, value_type(0));
+                         else if (b != value_type(1))
+                           for (size_t i(begin); i < end; i++)
+                             py[i] *= b;
+                         if (a != value_type(0))
+                           gemv_kernel(end-begin, n, a, pA+begin, lda, px, py+begin);
+                       }, std::max(size_t(64), (size_t(1)<<15)/std::max(n, size_t(1))));
+          return;
+        }
+
+    for (size_t i(0); i < m; i++)
+      y[i] = (beta == C(0) ? value_type(0) : beta*y[i]);
+    if (alpha == C(0))
+      return;
+    for (size_t j(0); j < n; j++)
+      {
+        const value_type t(alpha*x[j]);
+        for (size_t i(0); i < m; i++)
+          y[i] += t*A(i,j);
+      }
+  }
+
+  template <class C, class MATRIX1, class MATRIX2, class MATRIX3>
+  void gemm(const C alpha, const MATRIX1& A, const MATRIX2& B,
+            const C beta, MATRIX3& D)
+  {
+    typedef typename MATRIX3::value_type value_type;
+    assert(A.column_dimension() == B.row_dimension());
+    assert(A.row_dimension() == D.row_dimension());
+    assert(B.column_dimension() == D.column_dimension());
+    const size_t m(D.row_dimension()), n(D.column_dimension()), k(A.column_dimension());
+    if (m == 0 || n == 0)
+      return;
+
+    size_t lda(0), ldb(0), ldd(0);
+    const auto pA(column_major_storage(A, lda));
+    const auto pB(column_major_storage(B, ldb));
+    const auto pD(column_major_storage(D, ldd));
+    if constexpr (std::is_same_v<typename MATRIX1::value_type, value_type>
+                  && std::is_same_v<typename MATRIX2::value_type, value_type>)
+      if (pA != nullptr && pB != nullptr && pD != nullptr)
+        {
+          // each thread works on its own block of columns of D
+          const value_type a(alpha), b(beta);
+          const size_t grain(std::max(size_t(4), (size_t(1)<<18)/std::max(m*k, size_t(1))));
+          parallel_for(0, n, [=](const size_t begin, const size_t end, const unsigned int)
+                       {
+                         gemm_kernel(m, k, begin, end, a, pA, lda, pB, ldb, b, pD, ldd);
+                       }, grain);
+          return;
+        }
+
+    for (size_t j(0); j < n; j++)
+      {
+        for (size_t i(0); i < m; i++)
+          D(i,j) = (beta == C(0) ? value_type(0) : beta*D(i,j));
+        if (alpha == C(0))
+          continue;
+        for (size_t p(0); p < k; p++)
+          {
+            const value_type t(alpha*B(p,j));
+            for (size_t i(0); i < m; i++)
+              D(i,j) += t*A(i,p);
+          }
+      }
+  }
+}
@@ -0,0 +1,72 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_BLAS_H
+#define _AMSTEL_BLAS_H
+
+#include <cstddef>
+
+namespace AMSTeL
+{
+  /*!
+    Dense BLAS-like kernels on generic vectors and matrices.
+
+    A VECTOR has to provide size() and operator [] (cf. Array1D, Array1DView),
+    a MATRIX has to provide row_dimension(), column_dimension() and
+    operator () (cf. Array2D, Array2DView), i.e., the same interface as
+    required by print_vector() and print_matrix().
+
+    For contiguous column-major storage (Array1D, Array2D<C,ColumnMajor> and
+    views with unit row stride), the routines switch to register- and
+    cache-blocked kernels on the raw storage, which are written such that
+    the compiler can vectorize the innermost loops along the (aligned) columns.
+    Large problems are distributed over number_of_threads() threads.
+
+    As in the reference BLAS, the output arguments must not alias the inputs,
+    and for beta == 0, the previous entries of the output are never read.
+  */
+
+  /*!
+    y += alpha*x
+  */
+  template <class C, class VECTOR1, class VECTOR2>
+  void axpy(const C alpha, const VECTOR1& x, VECTOR2& y);
+
+  /*!
+    Euclidean inner product (x,y)
+  */
+  template <class VECTOR1, class VECTOR2>
+  typename VECTOR1::value_type dot(const VECTOR1& x, const VECTOR2& y);
+
+  /*!
+    Euclidean norm of x
+  */
+  template <class VECTOR>
+  typename VECTOR::value_type nrm2(const VECTOR& x);
+
+  /*!
+    matrix-vector product y = alpha*A*x + beta*y
+  */
+  template <class C, class MATRIX, class VECTOR1, class VECTOR2>
+  void gemv(const C alpha, const MATRIX& A, const VECTOR1& x,
+            const C beta, VECTOR2& y);
+
+  /*!
+    matrix-matrix product D = alpha*A*B + beta*D
+  */
+  template <class C, class MATRIX1, class MATRIX2, class MATRIX3>
+  void gemm(const C alpha, const MATRIX1& A, const MATRIX2& B,
+            const C beta, MATRIX3& D);
+}
+
+#include "algebra/blas.cpp"
+
+#endif
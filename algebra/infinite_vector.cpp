@@ -1,6 +1,7 @@
 // implementation of InfiniteVector inline functions
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include <unordered_map>
@@ -42,6 +43,14 @@ namespace AMSTeL
   {
     return const_iterator(*this, CONTAINER::end());
   }
+
+  template <class C, class I, class CONTAINER>
+  inline
+  typename InfiniteVector<C,I,CONTAINER>::const_iterator
+  InfiniteVector<C,I,CONTAINER>::lower_bound(const I& index) const
+  {
+    return const_iterator(*this, CONTAINER::lower_bound(index));
+  }
   
   template <class C, class I, class CONTAINER>
   InfiniteVector<C,I,CONTAINER>&
@@ -115,7 +124,7 @@ namespace AMSTeL
     else
     {
       // generic code for ordered container classes like std::map
-      typename CONTAINER::const_iterator it(this->lower_bound(index));
+      typename CONTAINER::const_iterator it(CONTAINER::lower_bound(index));
       if (it != CONTAINER::end())
       {
         if (!CONTAINER::key_comp()(index, it->first))
@@ -141,7 +150,7 @@ namespace AMSTeL
     {
       // generic code for ordered container classes like std::map
       // efficient add-or-update, cf. Meyers, Effective STL
-      typename CONTAINER::iterator it(this->lower_bound(index));
+      typename CONTAINER::iterator it(CONTAINER::lower_bound(index));
       if (it != CONTAINER::end() &&
           !CONTAINER::key_comp()(index, it->first))
         return it->second;
@@ -166,7 +175,7 @@ namespace AMSTeL
     else
     {
       // generic code for ordered container classes like std::map
-      typename CONTAINER::iterator it(this->lower_bound(index));
+      typename CONTAINER::iterator it(CONTAINER::lower_bound(index));
       if (it != CONTAINER::end() &&
           !CONTAINER::key_comp()(index,it->first)) {
         it->second = value;
@@ -212,6 +221,83 @@ namespace AMSTeL
     CONTAINER::swap(v);
   }
 
+  template <class C, class I, class CONTAINER>
+  void
+  InfiniteVector<C,I,CONTAINER>::delta(const InfiniteVector<C,I,CONTAINER>& marker,
+                                       InfiniteVector<C,I,CONTAINER>& changed,
+                                       std::set<I>& erased) const
+  {
+    CONTAINER help;
+    erased.clear();
+
+    // note: the following code, avoiding explicit specializations, will only compile in C++17 and onwards
+    if constexpr (std::is_same_v<std::unordered_map<I,C>, CONTAINER>)
+    {
+      for (const_iterator it(begin()), itend(end()); it != itend; ++it)
+        {
+          typename CONTAINER::const_iterator mit(marker.find(it.index()));
+          if (mit == marker.CONTAINER::end() || mit->second != it.value())
+            help.insert(std::pair<I,C>(it.index(), it.value()));
+        }
+      for (const_iterator mit(marker.begin()), mitend(marker.end()); mit != mitend; ++mit)
+        if (this->find(mit.index()) == CONTAINER::end())
+          erased.insert(mit.index());
+    }
+    else
+    {
+      // merge-like O(N) algorithm, cf. add()
+      const_iterator it(begin()), itend(end()), mit(marker.begin()), mitend(marker.end());
+      typename CONTAINER::iterator hint(help.begin());
+
+      while (it != itend && mit != mitend)
+        {
+          if (it.index() < mit.index())
+          {
+            // entry has been inserted
+            hint = help.insert(hint, std::pair<I,C>(it.index(), it.value()));
+            ++it;
+          }
+          else
+          {
+            if (mit.index() < it.index())
+            {
+              // entry has been erased
+              erased.insert(erased.end(), mit.index());
+              ++mit;
+            }
+            else
+            {
+              if (it.value() != mit.value())
+                hint = help.insert(hint, std::pair<I,C>(it.index(), it.value()));
+              ++it;
+              ++mit;
+            }
+          }
+        }
+
+      for (; it != itend; ++it)
+        hint = help.insert(hint, std::pair<I,C>(it.index(), it.value()));
+
+      for (; mit != mitend; ++mit)
+        erased.insert(erased.end(), mit.index());
+    }
+
+    changed.CONTAINER::swap(help);
+  }
+
+  template <class C, class I, class CONTAINER>
+  void
+  InfiniteVector<C,I,CONTAINER>::apply_delta(const InfiniteVector<C,I,CONTAINER>& changed,
+                                             const std::set<I>& erased)
+  {
+    for (typename std::set<I>::const_iterator it(erased.begin()), itend(erased.end());
+         it != itend; ++it)
+      CONTAINER::erase(*it);
+
+    for (const_iterator it(changed.begin()), itend(changed.end()); it != itend; ++it)
+      set_coefficient(it.index(), it.value());
+  }
+
 //  template <class C, class I>
 //  void InfiniteVector<C,I>::compress(const double eta)
 //  {
@@ -261,7 +347,7 @@ namespace AMSTeL
     {
       // generic code for ordered container classes like std::map
       // efficient add-or-update, cf. Meyers, Effective STL
-      typename CONTAINER::iterator it(this->lower_bound(index));
+      typename CONTAINER::iterator it(CONTAINER::lower_bound(index));
       if (it != CONTAINER::end() &&
         !CONTAINER::key_comp()(index, it->first))
       {
@@ -72,6 +72,13 @@ namespace AMSTeL
     */
     const_iterator end() const;
 
+    /*!
+     \brief const_iterator pointing to the first nontrivial vector entry
+     with an index not less than the given one (only for ordered containers),
+     which allows for linear-time walks over index ranges
+    */
+    const_iterator lower_bound(const I& index) const;
+
     /*!
      \brief assignment from another vector
     */
@@ -137,6 +144,23 @@ namespace AMSTeL
     */
     void clip(const std::set<I>& supp);
 
+    /*!
+      \brief changes of the current vector relative to an older state (a marker):
+      entries which have been inserted or modified since the marker are stored
+      in changed, the indices of erased entries are stored in erased
+      (linear-time merge for ordered containers)
+    */
+    void delta(const InfiniteVector<C,I,CONTAINER>& marker,
+               InfiniteVector<C,I,CONTAINER>& changed,
+               std::set<I>& erased) const;
+
+    /*!
+      \brief replay a delta as computed by delta(), i.e., overwrite the entries
+      from changed and erase the entries with indices from erased
+    */
+    void apply_delta(const InfiniteVector<C,I,CONTAINER>& changed,
+                     const std::set<I>& erased);
+
 //    /*!
 //      set all values with modulus strictly below a threshold eta to zero
 //      (fabs<C> should exist)
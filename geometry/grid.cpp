@@ -1,25 +1,120 @@
 // implementation for grid.h
 
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <bit>
+
 namespace AMSTeL
 {
   inline
   Grid<1>::Grid()
-    : grid_()
+    : grid_(), tree_(), a_(0), b_(0), N_(0), equidistant_(false)
   {
   }
 
   inline
   Grid<1>::Grid(const Array1D<double>& grid)
-    : grid_(grid)
+    : grid_(std::make_shared<const Array1D<double> >(grid)), tree_(),
+      a_(0), b_(0), N_(0), equidistant_(false)
   {
+    if (grid.size() >= 2)
+      {
+	auto tree(std::make_shared<SearchTree>());
+	tree->keys.resize(grid.size()+1);
+	tree->indices.resize(grid.size()+1);
+	unsigned int i(0);
+	build_tree(grid, *tree, i, 1);
+	tree_ = tree;
+      }
+  }
+
+  inline
+  void
+  Grid<1>::build_tree(const Array1D<double>& grid, SearchTree& tree,
+		      unsigned int& i, const size_t k)
+  {
+    if (k < tree.keys.size())
+      {
+	build_tree(grid, tree, i, 2*k);
+	tree.keys[k] = grid[i];
+	tree.indices[k] = i++;
+	build_tree(grid, tree, i, 2*k+1);
+      }
   }
 
   inline
   Grid<1>::Grid(const double a, const double b, const unsigned int N)
-    : grid_(N+1)
+    : grid_(), tree_(), a_(a), b_(b), N_(N), equidistant_(N > 0)
+  {
+    if (N == 0)
+      {
+	Array1D<double> grid(1);
+	grid[0] = a;
+	grid_ = std::make_shared<const Array1D<double> >(std::move(grid));
+      }
+  }
+
+  inline
+  unsigned int
+  Grid<1>::locate(const double x) const
+  {
+    const unsigned int n(size());
+    if (n < 2)
+      return 0;
+
+    if (equidistant_)
+      {
+	const double t((x-a_)/(b_-a_)*N_);
+	return t <= 0 ? 0 : (t >= N_-1 ? N_-1 : (unsigned int) t);
+      }
+
+    // descend without branches, the comparison result selects the child
+    const double* keys(tree_->keys.begin());
+    size_t k(1);
+    while (k <= n)
+      k = 2*k + (keys[k] <= x);
+    // undo the right turns after the last left turn, yielding the first key > x
+    k >>= std::countr_one(k) + 1;
+    const unsigned int r(k == 0 ? n : tree_->indices[k]); // upper bound
+    return r == 0 ? 0 : std::min(r-1, n-2);
+  }
+
+  inline
+  bool
+  Grid<1>::shares_grid(const Grid<1>& grid) const
+  {
+    if (equidistant_ || grid.equidistant_)
+      return equidistant_ == grid.equidistant_
+	&& a_ == grid.a_ && b_ == grid.b_ && N_ == grid.N_;
+    return grid_ == grid.grid_;
+  }
+
+  inline
+  bool
+  Grid<1>::same_grid(const Grid<1>& grid) const
   {
-    for (unsigned int n(0); n <= N; n++)
-      grid_[n] = a+((b-a)*n)/N;
+    if (shares_grid(grid))
+      return true;
+    if (size() != grid.size())
+      return false;
+    for (unsigned int i(0); i < size(); i++)
+      if (point(i) != grid.point(i))
+	return false;
+    return true;
+  }
+
+  inline
+  Array1D<double>
+  Grid<1>::points() const
+  {
+    if (!equidistant_)
+      return grid_ ? *grid_ : Array1D<double>();
+
+    Array1D<double> points(size());
+    for (unsigned int n(0); n <= N_; n++)
+      points[n] = point(n);
+    return points;
   }
   
   inline
@@ -27,80 +122,298 @@ namespace AMSTeL
   Grid<1>::matlab_output(std::ostream& os) const
   {
     os << "x = "
-       << grid_
+       << points()
        << ";"
        << std::endl;
   }
   
   inline
   Grid<2>::Grid()
-    : gridx_(), gridy_()
+    : axis_x_(), axis_y_(), gridx_(), gridy_()
   {
   }
 
   inline
   Grid<2>::Grid(const Array2D<double>& gridx, const Array2D<double>& gridy)
-    : gridx_(gridx), gridy_(gridy)
+    : axis_x_(), axis_y_(), gridx_(), gridy_()
   {
+    assert(gridx.row_dimension() == gridy.row_dimension()
+	   && gridx.column_dimension() == gridy.column_dimension());
+
+    // detect tensor product grids, gridx constant along the columns and gridy along the rows
+    const unsigned int rows(gridx.row_dimension()), columns(gridx.column_dimension());
+    bool tensor_product(true);
+    for (unsigned int n(0); n < columns && tensor_product; n++)
+      for (unsigned int m(0); m < rows; m++)
+	if (gridx(m,n) != gridx(0,n) || gridy(m,n) != gridy(m,0))
+	  {
+	    tensor_product = false;
+	    break;
+	  }
+
+    if (tensor_product && rows > 0 && columns > 0)
+      {
+	Array1D<double> x(columns), y(rows);
+	for (unsigned int n(0); n < columns; n++)
+	  x[n] = gridx(0,n);
+	for (unsigned int m(0); m < rows; m++)
+	  y[m] = gridy(m,0);
+	axis_x_ = Grid<1>(x);
+	axis_y_ = Grid<1>(y);
+      }
+    else
+      {
+	gridx_ = std::make_shared<const Array2D<double> >(gridx);
+	gridy_ = std::make_shared<const Array2D<double> >(gridy);
+      }
   }
 
   inline
   Grid<2>::Grid(const Grid<1>& gridx, const Grid<1>& gridy)
-    : gridx_(gridy.size(), gridx.size()),
-      gridy_(gridy.size(), gridx.size())
+    : axis_x_(gridx), axis_y_(gridy), gridx_(), gridy_()
   {
-    for (unsigned int n_x(0); n_x < gridx.size(); n_x++)
-      for (unsigned int n_y(0); n_y < gridy.size(); n_y++)
-	{
-	  gridx_(n_y, n_x) = gridx.points()[n_x];
-	  gridy_(n_y, n_x) = gridy.points()[n_y];
-	}
   }
   
   inline
   Grid<2>::Grid(const double& a_1,const double& a_2, const double& b_1, const double&b_2,
 		const unsigned int N_x, const unsigned int N_y)
-    : gridx_(N_y+1, N_x+1), gridy_(N_y+1, N_x+1)
+    : axis_x_(a_1, b_1, N_x), axis_y_(a_2, b_2, N_y), gridx_(), gridy_()
   {
-    for (unsigned int n_x(0); n_x <= N_x; n_x++)
-      for (unsigned int n_y(0); n_y <= N_y; n_y++)
-	{
-	  gridx_(n_y, n_x) = a_1 + (b_1-a_1)*n_x/N_x;
-	  gridy_(n_y, n_x) = a_2 + (b_2-a_2)*n_y/N_y;
-	}
   }
 
   inline
   Grid<2>::Grid(const double& a_1,const double& a_2, const double& b_1, const double&b_2,
 		const unsigned int N)
-    : gridx_(N+1, N+1), gridy_(N+1, N+1)
+    : axis_x_(a_1, b_1, N), axis_y_(a_2, b_2, N), gridx_(), gridy_()
   {
-    for (unsigned int n_x(0); n_x <= N; n_x++)
-      for (unsigned int n_y(0); n_y <= N; n_y++)
-	{
-	  gridx_(n_y, n_x) = a_1 + (b_1-a_1)*n_x/N;
-	  gridy_(n_y, n_x) = a_2 + (b_2-a_2)*n_y/N;
-	}
   }
   
   inline
   Grid<2>&
   Grid<2>::operator = (const Grid<2>& grid)
   {
+    axis_x_ = grid.axis_x_;
+    axis_y_ = grid.axis_y_;
     gridx_ = grid.gridx_;
     gridy_ = grid.gridy_;
     return *this;
   }
 
+  inline
+  bool
+  Grid<2>::shares_grid(const Grid<2>& grid) const
+  {
+    if (is_tensor_product() || grid.is_tensor_product())
+      return is_tensor_product() == grid.is_tensor_product()
+	&& axis_x_.shares_grid(grid.axis_x_) && axis_y_.shares_grid(grid.axis_y_);
+    return gridx_ == grid.gridx_ && gridy_ == grid.gridy_;
+  }
+
+  inline
+  bool
+  Grid<2>::same_grid(const Grid<2>& grid) const
+  {
+    if (shares_grid(grid))
+      return true;
+    if (row_dimension() != grid.row_dimension() || column_dimension() != grid.column_dimension())
+      return false;
+    if (is_tensor_product() && grid.is_tensor_product())
+      return axis_x_.same_grid(grid.axis_x_) && axis_y_.same_grid(grid.axis_y_);
+    for (unsigned int n(0); n < column_dimension(); n++)
+      for (unsigned int m(0); m < row_dimension(); m++)
+	if (x(m,n) != grid.x(m,n) || y(m,n) != grid.y(m,n))
+	  return false;
+    return true;
+  }
+
+  inline
+  Array2D<double>
+  Grid<2>::gridx() const
+  {
+    if (!is_tensor_product())
+      return *gridx_;
+
+    Array2D<double> gridx(row_dimension(), column_dimension());
+    for (unsigned int n(0); n < column_dimension(); n++)
+      for (unsigned int m(0); m < row_dimension(); m++)
+	gridx(m,n) = x(m,n);
+    return gridx;
+  }
+
+  inline
+  Array2D<double>
+  Grid<2>::gridy() const
+  {
+    if (!is_tensor_product())
+      return *gridy_;
+
+    Array2D<double> gridy(row_dimension(), column_dimension());
+    for (unsigned int n(0); n < column_dimension(); n++)
+      for (unsigned int m(0); m < row_dimension(); m++)
+	gridy(m,n) = y(m,n);
+    return gridy;
+  }
+
   inline
   void
   Grid<2>::matlab_output(std::ostream& os) const
   {
-    os << "x = "<< gridx_;
+    if (is_tensor_product())
+      {
+	os << "[x,y] = meshgrid(" << axis_x_.points()
+	   << "," << axis_y_.points() << ");" << std::endl;
+	return;
+      }
+
+    os << "x = "<< *gridx_;
     os << ";" << std::endl;
     
-    os << "y = "<< gridy_;
+    os << "y = "<< *gridy_;
     os << ";" << std::endl;
   }
-   
+
+  inline
+  void
+  Grid<2>::octave_output(std::ostream& os) const
+  {
+    // the Matlab output is Octave-compatible
+    matlab_output(os);
+  }
+
+  inline
+  bool
+  Grid<2>::is_equidistant() const
+  {
+    const unsigned int rows(row_dimension()), columns(column_dimension());
+    if (rows < 2 || columns < 2)
+      return false;
+
+    const double h_1((x(0, columns-1)-x(0,0))/(columns-1));
+    const double h_2((y(rows-1, 0)-y(0,0))/(rows-1));
+    const double tol(1e-12*(std::fabs(h_1)+std::fabs(h_2)));
+
+    if (is_tensor_product())
+      {
+	if (axis_x_.is_equidistant() && axis_y_.is_equidistant())
+	  return true;
+
+	// it suffices to check the axes
+	for (unsigned int n(0); n < columns; n++)
+	  if (std::fabs(x(0,n) - (x(0,0) + n*h_1)) > tol)
+	    return false;
+	for (unsigned int m(0); m < rows; m++)
+	  if (std::fabs(y(m,0) - (y(0,0) + m*h_2)) > tol)
+	    return false;
+	return true;
+      }
+
+    for (unsigned int n(0); n < columns; n++)
+      for (unsigned int m(0); m < rows; m++)
+        if (std::fabs(x(m,n) - (x(0,0) + n*h_1)) > tol
+            || std::fabs(y(m,n) - (y(0,0) + m*h_2)) > tol)
+          return false;
+
+    return true;
+  }
+
+  template <unsigned int DIM>
+  inline
+  Grid<DIM>::Grid()
+  {
+  }
+
+  template <unsigned int DIM>
+  inline
+  Grid<DIM>::Grid(std::initializer_list<Grid<1> > axes)
+  {
+    assert(axes.size() == DIM);
+    std::copy(axes.begin(), axes.end(), axes_);
+  }
+
+  template <unsigned int DIM>
+  inline
+  Grid<DIM>::Grid(const Grid<1>& axis)
+  {
+    std::fill(axes_, axes_+DIM, axis);
+  }
+
+  template <unsigned int DIM>
+  inline
+  Grid<DIM>::Grid(const double a, const double b, const unsigned int N)
+  {
+    std::fill(axes_, axes_+DIM, Grid<1>(a, b, N));
+  }
+
+  template <unsigned int DIM>
+  inline
+  size_t
+  Grid<DIM>::size() const
+  {
+    size_t n(1);
+    for (unsigned int k(0); k < DIM; k++)
+      n *= axes_[k].size();
+    return n;
+  }
+
+  template <unsigned int DIM>
+  inline
+  Grid<DIM-1>
+  Grid<DIM>::slice_grid() const
+  {
+    if constexpr (DIM == 3)
+      return Grid<2>(axes_[0], axes_[1]);
+    else
+      {
+	Grid<DIM-1> grid;
+	std::copy(axes_, axes_+DIM-1, grid.axes_);
+	return grid;
+      }
+  }
+
+  template <unsigned int DIM>
+  inline
+  bool
+  Grid<DIM>::is_equidistant() const
+  {
+    for (unsigned int k(0); k < DIM; k++)
+      if (!axes_[k].is_equidistant())
+	return false;
+    return true;
+  }
+
+  template <unsigned int DIM>
+  inline
+  bool
+  Grid<DIM>::shares_grid(const Grid<DIM>& grid) const
+  {
+    for (unsigned int k(0); k < DIM; k++)
+      if (!axes_[k].shares_grid(grid.axes_[k]))
+	return false;
+    return true;
+  }
+
+  template <unsigned int DIM>
+  inline
+  bool
+  Grid<DIM>::same_grid(const Grid<DIM>& grid) const
+  {
+    for (unsigned int k(0); k < DIM; k++)
+      if (!axes_[k].same_grid(grid.axes_[k]))
+	return false;
+    return true;
+  }
+
+  template <unsigned int DIM>
+  inline
+  void
+  Grid<DIM>::matlab_output(std::ostream& os) const
+  {
+    os << "[";
+    for (unsigned int k(0); k < DIM; k++)
+      os << (k > 0 ? "," : "") << "x" << k+1;
+    os << "] = ndgrid(";
+    for (unsigned int k(0); k < DIM; k++)
+      os << (k > 0 ? "," : "") << axes_[k].points();
+    os << ");" << std::endl;
+  }
 }
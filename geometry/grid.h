@@ -12,6 +12,8 @@
 #ifndef _AMSTeL_GRID_H
 #define _AMSTeL_GRID_H
 
+#include <initializer_list>
+#include <memory>
 #include <utils/array1d.h>
 #include <utils/array2d.h>
 
@@ -24,32 +26,23 @@ namespace AMSTeL
     A 1-dimensional grid is just a vector x holding the mesh points.
     A 2-dimensional grid (a so-called quad-mesh) consists of 2 matrices x and y,
     holding the x- and y-coordinates of the mesh points.
+    Grids in higher dimensions are tensor products of DIM 1-dimensional axes
+    (see the general template below the specializations).
     
     reference: Matlab/Octave help for the command 'surf'
    */
   template <unsigned int DIM>
-  class Grid
-  {
-  public:
-    /*!
-      default constructor: empty grid
-    */
-    Grid() {}
-
-    /*!
-      number of grid points
-    */
-    unsigned int size() const;
-
-    /*!
-      Matlab output of the grid onto a stream
-    */
-    void matlab_output(std::ostream& os) const;
-  };
+  class Grid;
 
   /*!
     specialization of Grid to one space dimension:
     1-dimensional grids are just vectors (1D arrays) holding the mesh points.
+    Equidistant grids only store the interval [a,b] and the number of
+    subintervals N, the mesh points are computed on access, and
+    the cell containing a given point is found in O(1).
+    Grids are immutable, and copies share the storage of the mesh points
+    (reference-counted), so that many sampled mappings over the same grid
+    hold only one copy of the points.
   */
   template <>
   class Grid<1>
@@ -73,12 +66,45 @@ namespace AMSTeL
     /*!
       number of grid points
     */
-    inline unsigned int size() const { return grid_.size(); }
+    inline unsigned int size() const { return equidistant_ ? N_+1 : (grid_ ? grid_->size() : 0); }
 
     /*!
-      reading access to the grid points
+      the i-th grid point
     */
-    inline const Array1D<double>& points() const { return grid_; }
+    inline double point(const unsigned int i) const
+    { return equidistant_ ? a_+((b_-a_)*i)/N_ : (*grid_)[i]; }
+
+    /*!
+      index k of the cell [x_k,x_{k+1}] containing x, for increasing grid points;
+      points outside the grid are assigned to the first or last cell
+      (O(1) for equidistant grids, otherwise a branchless binary search
+      in a copy of the points in Eytzinger (breadth-first) order,
+      which keeps the first levels of the search tree in cache)
+    */
+    unsigned int locate(const double x) const;
+
+    /*!
+      check whether the grid is stored as an equidistant grid
+    */
+    inline bool is_equidistant() const { return equidistant_; }
+
+    /*!
+      O(1) check whether both grids are known to be identical, i.e., they share
+      the storage of the points or are equidistant with the same parameters
+    */
+    bool shares_grid(const Grid<1>& grid) const;
+
+    /*!
+      check whether both grids consist of the same points
+      (O(1) if shares_grid() holds, pointwise comparison otherwise)
+    */
+    bool same_grid(const Grid<1>& grid) const;
+
+    /*!
+      the grid points (computed on demand for equidistant grids,
+      prefer point(i) for large grids)
+    */
+    Array1D<double> points() const;
 
     /*!
       Matlab output of the grid onto a stream
@@ -87,15 +113,44 @@ namespace AMSTeL
     
   protected:
     /*!
-      internal storage for the grid points
+      shared storage for the grid points (0 for equidistant and empty grids)
     */
-    Array1D<double> grid_;
+    std::shared_ptr<const Array1D<double> > grid_;
+
+    /*!
+      search tree for locate() on non-equidistant grids: the grid points in
+      Eytzinger order (1-based, keys[0] is unused) and their indices in the grid
+    */
+    struct SearchTree
+    {
+      Array1D<double> keys;
+      Array1D<unsigned int> indices;
+    };
+    std::shared_ptr<const SearchTree> tree_;
+
+    /*!
+      interval and number of subintervals of an equidistant grid
+    */
+    double a_, b_;
+    unsigned int N_;
+    bool equidistant_;
+
+  private:
+    /*!
+      in-order traversal of the search tree, starting at node k
+    */
+    static void build_tree(const Array1D<double>& grid, SearchTree& tree,
+			   unsigned int& i, const size_t k);
   };
 
 /*!
     specialization of Grid to two space dimensions:
     2-dimensional grids (quad-meshes) consist of 2 matrices (2D arrays) x and y,
-    holding the x- and y-coordinates of the mesh points
+    holding the x- and y-coordinates of the mesh points.
+    Tensor product grids x(m,n) = x_n, y(m,n) = y_m (the usual case) only store
+    the two 1D axes, and the coordinates are computed on access; the full
+    matrices are only stored for genuinely curvilinear grids.
+    As for Grid<1>, copies share the (immutable) coordinates.
   */
   template <>
   class Grid<2>
@@ -107,7 +162,8 @@ namespace AMSTeL
     Grid();
 
     /*!
-      construct a 2D grid from two matrices 
+      construct a 2D grid from two matrices
+      (tensor product grids are detected and stored by their axes)
     */
     Grid(const Array2D<double>& gridx, const Array2D<double>& gridy);
 
@@ -128,32 +184,195 @@ namespace AMSTeL
     Grid(const double& a_1,const double& a_2, const double& b_1, const double&b_2,
 	 const unsigned int N);
 
+    /*!
+      copy constructor
+    */
+    Grid(const Grid<2>& grid) = default;
+
+    /*!
+      move constructor
+    */
+    Grid(Grid<2>&& grid) noexcept = default;
+
     /*!
       number of grid points
     */
-    inline unsigned int size() const { return gridx_.size(); }
+    inline unsigned int size() const { return row_dimension()*column_dimension(); }
+
+    /*!
+      number of grid points in y direction (rows of the coordinate matrices)
+    */
+    inline unsigned int row_dimension() const
+    { return is_tensor_product() ? axis_y_.size() : gridx_->row_dimension(); }
+
+    /*!
+      number of grid points in x direction (columns of the coordinate matrices)
+    */
+    inline unsigned int column_dimension() const
+    { return is_tensor_product() ? axis_x_.size() : gridx_->column_dimension(); }
 
     /*!
       assignment operator
     */
     Grid<2>& operator = (const Grid<2>& grid);
 
+    /*!
+      move assignment
+    */
+    Grid<2>& operator = (Grid<2>&& grid) noexcept = default;
+
     /*!
       Matlab output of the grid onto a stream
+      (tensor product grids are written via meshgrid)
     */
     void matlab_output(std::ostream& os) const;
-    
+
+    /*!
+      Octave-compatible output of the grid onto a stream
+    */
+    void octave_output(std::ostream& os) const;
+
+    /*!
+      check whether the grid is an equidistant tensor product grid, i.e.,
+      x(m,n) = a_1 + n*h_1 and y(m,n) = a_2 + m*h_2
+    */
+    bool is_equidistant() const;
+
+    /*!
+      check whether the grid is stored as a tensor product of two 1D axes
+    */
+    inline bool is_tensor_product() const { return !gridx_; }
+
+    /*!
+      coordinates of the grid point (m,n)
+    */
+    inline double x(const unsigned int m, const unsigned int n) const
+    { return is_tensor_product() ? axis_x_.point(n) : (*gridx_)(m,n); }
+    inline double y(const unsigned int m, const unsigned int n) const
+    { return is_tensor_product() ? axis_y_.point(m) : (*gridy_)(m,n); }
+
+    /*!
+      O(1) check whether both grids are known to be identical
+      (shared coordinates or identical axes, cf. Grid<1>::shares_grid())
+    */
+    bool shares_grid(const Grid<2>& grid) const;
+
+    /*!
+      check whether both grids consist of the same points
+      (O(1) if shares_grid() holds, pointwise comparison otherwise)
+    */
+    bool same_grid(const Grid<2>& grid) const;
+
+    /*!
+      the 1D axes of a tensor product grid (empty for curvilinear grids)
+    */
+    inline const Grid<1>& axis_x() const { return axis_x_; }
+    inline const Grid<1>& axis_y() const { return axis_y_; }
+
     /*!
-      read access to the grid points
+      the full coordinate matrices (computed on demand for tensor product grids,
+      prefer x(m,n) and y(m,n) for large grids)
     */
-    inline const Array2D<double>& gridx() const { return gridx_; }
-    inline const Array2D<double>& gridy() const { return gridy_; }
+    Array2D<double> gridx() const;
+    Array2D<double> gridy() const;
     
   protected:
     /*!
-      internal storage for the grid points
+      the axes of a tensor product grid
+    */
+    Grid<1> axis_x_, axis_y_;
+
+    /*!
+      shared storage for the grid points of a curvilinear grid
+      (0 for tensor product grids)
+    */
+    std::shared_ptr<const Array2D<double> > gridx_, gridy_;
+  };
+
+  /*!
+    general DIM-dimensional tensor product grid, the mesh points of which are
+    (x^{(0)}_{i_0},...,x^{(DIM-1)}_{i_{DIM-1}}) for DIM 1-dimensional axes.
+    Only the axes are stored, so that the grid is cheap even for large 3D volumes.
+    The points are numbered with the first index running fastest
+    (as in Matlab's ndgrid and in VTK image data), and the grid consists
+    of the slices i_{DIM-1} = 0,...,dimension(DIM-1)-1.
+  */
+  template <unsigned int DIM>
+  class Grid
+  {
+  public:
+    /*!
+      default constructor: empty grid
+    */
+    Grid();
+
+    /*!
+      construct a tensor product grid from DIM 1D grids
+    */
+    Grid(std::initializer_list<Grid<1> > axes);
+
+    /*!
+      construct a tensor product grid with the same axis in all directions
+    */
+    explicit Grid(const Grid<1>& axis);
+
+    /*!
+      construct an equidistant grid on [a,b]^DIM with (N+1)^DIM points
+    */
+    Grid(const double a, const double b, const unsigned int N);
+
+    /*!
+      number of grid points
+    */
+    size_t size() const;
+
+    /*!
+      number of grid points in direction k
+    */
+    inline unsigned int dimension(const unsigned int k) const { return axes_[k].size(); }
+
+    /*!
+      the 1D axis in direction k
+    */
+    inline const Grid<1>& axis(const unsigned int k) const { return axes_[k]; }
+
+    /*!
+      number of slices, i.e., grid points in the last direction
+    */
+    inline unsigned int slices() const { return axes_[DIM-1].size(); }
+
+    /*!
+      the (DIM-1)-dimensional grid of a single slice
+    */
+    Grid<DIM-1> slice_grid() const;
+
+    /*!
+      check whether all axes are equidistant
+    */
+    bool is_equidistant() const;
+
+    /*!
+      O(1) check whether both grids are known to be identical
+    */
+    bool shares_grid(const Grid<DIM>& grid) const;
+
+    /*!
+      check whether both grids consist of the same points
+    */
+    bool same_grid(const Grid<DIM>& grid) const;
+
+    /*!
+      Matlab output of the grid onto a stream (via ndgrid)
+    */
+    void matlab_output(std::ostream& os) const;
+
+  protected:
+    template <unsigned int> friend class Grid;
+
+    /*!
+      the axes of the tensor product grid
     */
-    Array2D<double> gridx_, gridy_;
+    Grid<1> axes_[DIM];
   };
 }
 
@@ -1,6 +1,77 @@
 // implementation for sampled_mapping.h
+
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <span>
+#include <io/vtk_io.h>
+#include <utils/parallel_for.h>
+
 namespace AMSTeL
 {
+  /*
+    minimal number of values per thread in the pointwise operations
+  */
+  inline constexpr size_t sampled_mapping_grain(size_t(1)<<15);
+
+  /*
+    minimal number of function or interpolant evaluations per thread
+    in the batch evaluations and in sample()
+  */
+  inline constexpr size_t evaluation_grain(size_t(1)<<11);
+
+  /*
+    maximal number of points passed to a batched function in sample()
+  */
+  inline constexpr size_t sampling_batch(1024);
+
+  /*
+    interpolation stencil at x on a 1D grid: computes the first grid index
+    and the weights of the 2 (linear) or 4 (cubic) grid points involved,
+    returns the number of points (grids with less points fall back to lower order)
+  */
+  inline
+  unsigned int
+  interpolation_stencil(const Grid<1>& grid, const double x,
+			const interpolation method,
+			unsigned int& first, double* weights)
+  {
+    const unsigned int n(grid.size());
+    if (n == 0)
+      throw std::invalid_argument("interpolation on an empty grid");
+    const unsigned int k(grid.locate(x));
+
+    if (method == interpolation::cubic && n >= 4)
+      {
+	first = k == 0 ? 0 : std::min(k-1, n-4);
+	double t[4];
+	for (unsigned int i(0); i < 4; i++)
+	  t[i] = grid.point(first+i);
+	for (unsigned int i(0); i < 4; i++)
+	  {
+	    weights[i] = 1.0;
+	    for (unsigned int j(0); j < 4; j++)
+	      if (j != i)
+		weights[i] *= (x-t[j])/(t[i]-t[j]);
+	  }
+	return 4;
+      }
+
+    first = k;
+    if (n == 1)
+      {
+	weights[0] = 1.0;
+	return 1;
+      }
+    const double x_0(grid.point(k)), x_1(grid.point(k+1));
+    weights[1] = (x-x_0)/(x_1-x_0);
+    weights[0] = 1.0-weights[1];
+    return 2;
+  }
+
   template <class C>
   SampledMapping<1,C>::SampledMapping()
     : Grid<1>(), values_()
@@ -13,12 +84,16 @@ namespace AMSTeL
   {
   }
 
+  template <class C>
+  SampledMapping<1,C>::SampledMapping(SampledMapping<1,C>&& sm) noexcept
+    : Grid<1>(std::move(sm)), values_(std::move(sm.values_))
+  {
+  }
+
   template <class C>
   SampledMapping<1,C>::SampledMapping(const Grid<1>& grid)
-    : Grid<1>(grid), values_(grid.size())
+    : Grid<1>(grid), values_(grid.size(), first_touch)
   {
-    for (unsigned int i = 0; i < grid.size(); i++)
-      values_[i] = 0;
   }
 
   template <class C>
@@ -27,6 +102,17 @@ namespace AMSTeL
   {
   }
 
+  template <class C>
+  template <class FUNCTION>
+  requires std::is_invocable_v<FUNCTION, double>
+    || std::is_invocable_v<FUNCTION, std::span<const double>, std::span<C> >
+  SampledMapping<1,C>::SampledMapping(const Grid<1>& grid, FUNCTION f)
+    : Grid<1>(grid), values_(grid.size(), no_initialization)
+  {
+    // the values are first touched by the threads computing them
+    sample(f);
+  }
+
   template <class C>
   SampledMapping<1,C>::SampledMapping(const int a,
 				      const int b,
@@ -34,9 +120,13 @@ namespace AMSTeL
 				      const int resolution)
     : Grid<1>(a, b, (1<<resolution)*(b-a))
   {
-    values_.resize(Grid<1>::size());
-    for (int k(a<<resolution), n(0); k <= (b<<resolution); k++, n++)
-      values_[n] = values.get_coefficient(k);
+    values_.resize(Grid<1>::size(), first_touch);
+
+    // walk once through the entries in range, the other values are zero
+    const int first(a<<resolution), last(b<<resolution);
+    for (typename InfiniteVector<C,int>::const_iterator it(values.lower_bound(first)), itend(values.end());
+	 it != itend && it.index() <= last; ++it)
+      values_[it.index()-first] = it.value();
   }
   
   template <class C>
@@ -47,14 +137,26 @@ namespace AMSTeL
     values_ = sm.values_;
     return *this;
   }
+
+  template <class C>
+  SampledMapping<1,C>&
+  SampledMapping<1,C>::operator = (SampledMapping<1,C>&& sm) noexcept
+  {
+    Grid<1>::operator = (std::move(sm));
+    values_ = std::move(sm.values_);
+    return *this;
+  }
   
   template <class C>
   void
   SampledMapping<1,C>::add(const SampledMapping<1,C>& s)
   {
     assert(values_.size() == s.values_.size());
-    for (unsigned int i = 0; i < values_.size(); i++)
-      values_[i] += s.values_[i];
+    assert(Grid<1>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] += x[i]; },
+		  sampled_mapping_grain);
   }
 
   template <class C>
@@ -62,16 +164,187 @@ namespace AMSTeL
   SampledMapping<1,C>::add(const C alpha, const SampledMapping<1,C>& s)
   {
     assert(values_.size() == s.values_.size());
-    for (unsigned int i = 0; i < values_.size(); i++)
-      values_[i] += alpha * s.values_[i];
+    assert(Grid<1>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] += alpha*x[i]; },
+		  sampled_mapping_grain);
   }
 
   template <class C>
   void
   SampledMapping<1,C>::mult(const C alpha)
   {
-    for (unsigned int i = 0; i < values_.size(); i++)
-      values_[i] *= alpha;
+    C* y(values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] *= alpha; },
+		  sampled_mapping_grain);
+  }
+
+  template <class C>
+  void
+  SampledMapping<1,C>::axpby(const C alpha, const SampledMapping<1,C>& s, const C beta)
+  {
+    assert(values_.size() == s.values_.size());
+    assert(Grid<1>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] = alpha*x[i] + beta*y[i]; },
+		  sampled_mapping_grain);
+  }
+
+  template <class C>
+  void
+  SampledMapping<1,C>::add(const C alpha, const SampledMapping<1,C>& s,
+	      const C beta, const SampledMapping<1,C>& t)
+  {
+    assert(values_.size() == s.values_.size() && values_.size() == t.values_.size());
+    assert(Grid<1>::same_grid(s) && Grid<1>::same_grid(t));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    const C* z(t.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] += alpha*x[i] + beta*z[i]; },
+		  sampled_mapping_grain);
+  }
+
+  template <class C>
+  void
+  SampledMapping<1,C>::multiply(const SampledMapping<1,C>& s)
+  {
+    assert(values_.size() == s.values_.size());
+    assert(Grid<1>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] *= x[i]; },
+		  sampled_mapping_grain);
+  }
+
+  template <class C>
+  template <class FUNCTION>
+  void
+  SampledMapping<1,C>::apply(FUNCTION f)
+  {
+    C* y(values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] = f(y[i]); },
+		  sampled_mapping_grain);
+  }
+
+  template <class C>
+  template <class FUNCTION>
+  void
+  SampledMapping<1,C>::apply(FUNCTION f, const SampledMapping<1,C>& s)
+  {
+    assert(values_.size() == s.values_.size());
+    assert(Grid<1>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] = f(y[i], x[i]); },
+		  sampled_mapping_grain);
+  }
+
+  template <class C>
+  C
+  SampledMapping<1,C>::evaluate(const double x, const interpolation method) const
+  {
+    unsigned int first;
+    double weights[4];
+    const unsigned int points(interpolation_stencil(*this, x, method, first, weights));
+    C r(0);
+    for (unsigned int i(0); i < points; i++)
+      r += weights[i] * values_[first+i];
+    return r;
+  }
+
+  template <class C>
+  void
+  SampledMapping<1,C>::evaluate(const Array1D<double>& points, Array1D<C>& values,
+				const interpolation method) const
+  {
+    // check once, before the parallel loop
+    if (points.size() > 0 && size() == 0)
+      throw std::invalid_argument("interpolation on an empty grid");
+    values.resize(points.size());
+    const double* x(points.begin());
+    C* v(values.begin());
+    parallel_loop(0, points.size(),
+		  [=,this](const size_t i) { v[i] = evaluate(x[i], method); },
+		  evaluation_grain);
+  }
+
+  template <class C>
+  SampledMapping<1,C>
+  SampledMapping<1,C>::decimate(const unsigned int points) const
+  {
+    const size_t n(values_.size());
+    if (n <= points)
+      return *this;
+
+    Array1D<double> x;
+    Array1D<C> values;
+    x.reserve(points);
+    values.reserve(points);
+    if (points > 0)
+      {
+	x.push_back(point(0));
+	values.push_back(values_[0]);
+      }
+    if (points > 1)
+      {
+	// the interior points 1,...,n-2 are split into bins of two points each
+	const size_t bins((points-2)/2), interior(n-2);
+	for (size_t b(0); b < bins; b++)
+	  {
+	    const size_t begin(1+b*interior/bins), end(1+(b+1)*interior/bins);
+	    size_t i_min(begin), i_max(begin);
+	    for (size_t i(begin+1); i < end; i++)
+	      {
+		if (values_[i] < values_[i_min])
+		  i_min = i;
+		if (values_[i_max] < values_[i])
+		  i_max = i;
+	      }
+	    // keep the extrema in the order of the grid points
+	    const size_t first(std::min(i_min, i_max)), second(std::max(i_min, i_max));
+	    x.push_back(point(first));
+	    values.push_back(values_[first]);
+	    if (second != first)
+	      {
+		x.push_back(point(second));
+		values.push_back(values_[second]);
+	      }
+	  }
+	x.push_back(point(n-1));
+	values.push_back(values_[n-1]);
+      }
+    return SampledMapping<1,C>(Grid<1>(x), values);
+  }
+
+  template <class C>
+  template <class FUNCTION>
+  void
+  SampledMapping<1,C>::sample(FUNCTION f)
+  {
+    C* v(values_.begin());
+    if constexpr (std::is_invocable_v<FUNCTION, double>)
+      parallel_loop(0, values_.size(), [&,v](const size_t i) { v[i] = f(point(i)); },
+		    evaluation_grain);
+    else
+      parallel_for(0, values_.size(), [&,v](const size_t begin, const size_t end, const unsigned int)
+		   {
+		     double x[sampling_batch];
+		     for (size_t i(begin); i < end; i += sampling_batch)
+		       {
+			 const size_t k(std::min(sampling_batch, end-i));
+			 if (grid_)
+			   f(std::span<const double>(grid_->begin()+i, k), std::span<C>(v+i, k));
+			 else
+			   {
+			     // equidistant grids compute their points on the fly
+			     for (size_t j(0); j < k; j++)
+			       x[j] = point(i+j);
+			     f(std::span<const double>(x, k), std::span<C>(v+i, k));
+			   }
+		       }
+		   }, evaluation_grain);
   }
 
   template <class C>
@@ -94,11 +367,38 @@ namespace AMSTeL
   SampledMapping<1,C>::gnuplot_output(std::ostream& os) const
   {
     unsigned int i;
-    const unsigned int size = grid_.size();
+    const unsigned int size = Grid<1>::size();
     assert(values_.size() == size); // sizes of arrays must match
 
     for (i = 0; i < size; i++) // loop through entries
-      os << grid_[i] << "\t" << values_[i] << std::endl; // format: one value pair per row, in each row x y
+      os << point(i) << "\t" << values_[i] << std::endl; // format: one value pair per row, in each row x y
+  }
+
+  /*
+    pointwise loop f(y_i, x_i, ...) over the entries of 2D arrays of the same shape:
+    flat over the storage if no array is padded, column by column otherwise
+    (the padding entries are never touched)
+  */
+  template <class C, class FUNCTION, class... ARRAYS>
+  void
+  pointwise_loop(FUNCTION f, Array2D<C>& y, const ARRAYS&... x)
+  {
+    const size_t rows(y.row_dimension());
+    if (y.leading_dimension() == rows && ((x.leading_dimension() == rows) && ...))
+      parallel_loop(0, y.size(),
+		    [=, py = y.aligned_data(), ...px = x.aligned_data()](const size_t i) { f(py[i], px[i]...); },
+		    sampled_mapping_grain);
+    else
+      parallel_for(0, y.column_dimension(),
+		   [&](const size_t begin, const size_t end, const unsigned int)
+		   {
+		     for (size_t n(begin); n < end; n++)
+		       {
+			 C* py(&y(0,n));
+			 for (size_t m(0); m < rows; m++)
+			   f(py[m], x(m,n)...);
+		       }
+		   }, std::max<size_t>(1, sampled_mapping_grain/std::max<size_t>(1, rows)));
   }
 
   template <class C>
@@ -113,11 +413,17 @@ namespace AMSTeL
   {
   }
 
+  template <class C>
+  SampledMapping<2,C>::SampledMapping(SampledMapping<2,C>&& sm) noexcept
+    : Grid<2>(std::move(sm)), values_(std::move(sm.values_))
+  {
+  }
+
   template <class C>
   SampledMapping<2,C>::SampledMapping(const Grid<2>& grid)
-    : Grid<2>(grid)
+    : Grid<2>(grid),
+      values_(grid.row_dimension(), grid.column_dimension(), first_touch)
   {
-    values_.resize(gridx_.row_dimension(), gridx_.column_dimension());
   }
 
   template <class C>
@@ -126,6 +432,38 @@ namespace AMSTeL
   {
   }
 
+  template <class C>
+  template <class FUNCTION>
+  requires std::is_invocable_v<FUNCTION, double, double>
+    || std::is_invocable_v<FUNCTION, std::span<const double>, std::span<const double>, std::span<C> >
+  SampledMapping<2,C>::SampledMapping(const Grid<2>& grid, FUNCTION f)
+    : Grid<2>(grid), values_(grid.row_dimension(), grid.column_dimension(), no_initialization)
+  {
+    // the values and the padding are first touched by the threads computing them
+    sample(f);
+  }
+
+  template <class C>
+  SampledMapping<2,C>::SampledMapping(const int a_1, const int a_2, const int b_1, const int b_2,
+				      const InfiniteVector<C, std::pair<int,int> >& values,
+				      const int resolution)
+    : Grid<2>(a_1, a_2, b_1, b_2, (1<<resolution)*(b_1-a_1), (1<<resolution)*(b_2-a_2)),
+      values_(Grid<2>::row_dimension(), Grid<2>::column_dimension(), first_touch)
+  {
+    // the entries are sorted lexicographically, i.e., column by column,
+    // so that a single walk suffices; entries outside [a_2,b_2] are skipped
+    const int first_x(a_1<<resolution), last_x(b_1<<resolution);
+    const int first_y(a_2<<resolution), last_y(b_2<<resolution);
+    for (typename InfiniteVector<C, std::pair<int,int> >::const_iterator
+	   it(values.lower_bound(std::make_pair(first_x, first_y))), itend(values.end());
+	 it != itend && it.index().first <= last_x; ++it)
+      {
+	const int k_y(it.index().second);
+	if (k_y >= first_y && k_y <= last_y)
+	  values_(k_y-first_y, it.index().first-first_x) = it.value();
+      }
+  }
+
   template <class C>
   SampledMapping<2,C>&
   SampledMapping<2,C>::operator = (const SampledMapping<2,C>& sm)
@@ -135,15 +473,23 @@ namespace AMSTeL
     return *this;
   }
 
+  template <class C>
+  SampledMapping<2,C>&
+  SampledMapping<2,C>::operator = (SampledMapping<2,C>&& sm) noexcept
+  {
+    Grid<2>::operator = (std::move(sm));
+    values_ = std::move(sm.values_);
+    return *this;
+  }
+
   template <class C>
   void
   SampledMapping<2,C>::add(const SampledMapping<2,C>& s)
   {
     assert(values_.row_dimension() == s.values_.row_dimension()
 	   && values_.column_dimension() == s.values_.column_dimension());
-    for (unsigned int m(0); m < values_.row_dimension(); m++)
-      for (unsigned int n(0); n < values_.column_dimension(); n++)
-	values_(m,n) += s.values_(m,n);
+    assert(Grid<2>::same_grid(s));
+    pointwise_loop([](C& y, const C& x) { y += x; }, values_, s.values_);
   }
 
   template <class C>
@@ -152,40 +498,278 @@ namespace AMSTeL
   {
     assert(values_.row_dimension() == s.values_.row_dimension()
 	   && values_.column_dimension() == s.values_.column_dimension());
-    for (unsigned int m(0); m < values_.row_dimension(); m++)
-      for (unsigned int n(0); n < values_.column_dimension(); n++)
-	values_(m,n) += alpha * s.values_(m,n);
+    assert(Grid<2>::same_grid(s));
+    pointwise_loop([=](C& y, const C& x) { y += alpha*x; }, values_, s.values_);
   }
   
   template <class C>
   void
-  SampledMapping<2,C>::add(const Array2D<C>& mat)
+  SampledMapping<2,C>::add(const Array2DView<const C>& mat)
   {
-    assert(values_.row_dimension() == mat.row_dimension()
-	   && values_.column_dimension() == mat.column_dimension());
-    for (unsigned int m(0); m < values_.row_dimension(); m++)
-      for (unsigned int n(0); n < values_.column_dimension(); n++)
-	values_(m,n) += mat(m,n);
+    add(C(1), mat);
   }
   
   template <class C>
   void
-  SampledMapping<2,C>::add(const C alpha, const Array2D<C>& mat)
+  SampledMapping<2,C>::add(const C alpha, const Array2DView<const C>& mat)
   {
     assert(values_.row_dimension() == mat.row_dimension()
 	   && values_.column_dimension() == mat.column_dimension());
-    for (unsigned int m(0); m < values_.row_dimension(); m++)
-      for (unsigned int n(0); n < values_.column_dimension(); n++)
-	values_(m,n) += alpha * mat(m,n);
+    // parallel over the columns, the inner loop is contiguous for unit row stride
+    const size_t rows(values_.row_dimension());
+    parallel_for(0, values_.column_dimension(),
+		 [&](const size_t begin, const size_t end, const unsigned int)
+		 {
+		   for (size_t n(begin); n < end; n++)
+		     {
+		       C* y(&values_(0,n));
+		       if (mat.row_stride() == 1)
+			 {
+			   const C* x(&mat(0,n));
+			   for (size_t m(0); m < rows; m++)
+			     y[m] += alpha*x[m];
+			 }
+		       else
+			 for (size_t m(0); m < rows; m++)
+			   y[m] += alpha*mat(m,n);
+		     }
+		 }, std::max<size_t>(1, sampled_mapping_grain/std::max<size_t>(1, rows)));
   }
 
   template <class C>
   void
   SampledMapping<2,C>::mult(const C alpha)
   {
-    for (unsigned int m(0); m < values_.row_dimension(); m++)
-      for (unsigned int n(0); n < values_.column_dimension(); n++)
-	values_(m,n) *= alpha;    
+    pointwise_loop([=](C& y) { y *= alpha; }, values_);
+  }
+
+  template <class C>
+  void
+  SampledMapping<2,C>::axpby(const C alpha, const SampledMapping<2,C>& s, const C beta)
+  {
+    assert(values_.row_dimension() == s.values_.row_dimension()
+	   && values_.column_dimension() == s.values_.column_dimension());
+    assert(Grid<2>::same_grid(s));
+    pointwise_loop([=](C& y, const C& x) { y = alpha*x + beta*y; }, values_, s.values_);
+  }
+
+  template <class C>
+  void
+  SampledMapping<2,C>::add(const C alpha, const SampledMapping<2,C>& s,
+	      const C beta, const SampledMapping<2,C>& t)
+  {
+    assert(values_.row_dimension() == s.values_.row_dimension()
+	   && values_.column_dimension() == s.values_.column_dimension()
+	   && values_.row_dimension() == t.values_.row_dimension()
+	   && values_.column_dimension() == t.values_.column_dimension());
+    assert(Grid<2>::same_grid(s) && Grid<2>::same_grid(t));
+    pointwise_loop([=](C& y, const C& x, const C& z) { y += alpha*x + beta*z; },
+		   values_, s.values_, t.values_);
+  }
+
+  template <class C>
+  void
+  SampledMapping<2,C>::multiply(const SampledMapping<2,C>& s)
+  {
+    assert(values_.row_dimension() == s.values_.row_dimension()
+	   && values_.column_dimension() == s.values_.column_dimension());
+    assert(Grid<2>::same_grid(s));
+    pointwise_loop([](C& y, const C& x) { y *= x; }, values_, s.values_);
+  }
+
+  template <class C>
+  template <class FUNCTION>
+  void
+  SampledMapping<2,C>::apply(FUNCTION f)
+  {
+    // column by column, f is not applied to the padding
+    const size_t rows(values_.row_dimension());
+    parallel_for(0, values_.column_dimension(),
+		 [&](const size_t begin, const size_t end, const unsigned int)
+		 {
+		   for (size_t n(begin); n < end; n++)
+		     {
+		       C* y(&values_(0,n));
+		       for (size_t m(0); m < rows; m++)
+			 y[m] = f(y[m]);
+		     }
+		 }, std::max<size_t>(1, sampled_mapping_grain/std::max<size_t>(1, rows)));
+  }
+
+  template <class C>
+  template <class FUNCTION>
+  void
+  SampledMapping<2,C>::apply(FUNCTION f, const SampledMapping<2,C>& s)
+  {
+    assert(values_.row_dimension() == s.values_.row_dimension()
+	   && values_.column_dimension() == s.values_.column_dimension());
+    assert(Grid<2>::same_grid(s));
+    const size_t rows(values_.row_dimension());
+    parallel_for(0, values_.column_dimension(),
+		 [&](const size_t begin, const size_t end, const unsigned int)
+		 {
+		   for (size_t n(begin); n < end; n++)
+		     {
+		       C* y(&values_(0,n));
+		       const C* x(&s.values_(0,n));
+		       for (size_t m(0); m < rows; m++)
+			 y[m] = f(y[m], x[m]);
+		     }
+		 }, std::max<size_t>(1, sampled_mapping_grain/std::max<size_t>(1, rows)));
+  }
+
+  template <class C>
+  C
+  SampledMapping<2,C>::evaluate(const double x, const double y,
+				const interpolation method) const
+  {
+    if (!is_tensor_product())
+      throw std::invalid_argument("SampledMapping<2>::evaluate() needs a tensor product grid");
+    unsigned int first_x, first_y;
+    double weights_x[4], weights_y[4];
+    const unsigned int points_x(interpolation_stencil(axis_x(), x, method, first_x, weights_x));
+    const unsigned int points_y(interpolation_stencil(axis_y(), y, method, first_y, weights_y));
+    C r(0);
+    for (unsigned int j(0); j < points_x; j++)
+      {
+	C column(0);
+	for (unsigned int i(0); i < points_y; i++)
+	  column += weights_y[i] * values_(first_y+i, first_x+j);
+	r += weights_x[j] * column;
+      }
+    return r;
+  }
+
+  template <class C>
+  void
+  SampledMapping<2,C>::evaluate(const Array1D<double>& x, const Array1D<double>& y,
+				Array1D<C>& values,
+				const interpolation method) const
+  {
+    assert(x.size() == y.size());
+    // check once, before the parallel loop
+    if (x.size() > 0 && (!is_tensor_product() || values_.size() == 0))
+      throw std::invalid_argument("SampledMapping<2>::evaluate() needs a non-empty tensor product grid");
+    values.resize(x.size());
+    const double* px(x.begin());
+    const double* py(y.begin());
+    C* v(values.begin());
+    parallel_loop(0, x.size(),
+		  [=,this](const size_t i) { v[i] = evaluate(px[i], py[i], method); },
+		  evaluation_grain);
+  }
+
+  template <class C>
+  SampledMapping<2,C>
+  SampledMapping<2,C>::decimate(const unsigned int points_x,
+				const unsigned int points_y) const
+  {
+    if (!is_tensor_product())
+      throw std::invalid_argument("SampledMapping<2>::decimate() needs a tensor product grid");
+    const size_t rows(row_dimension()), columns(column_dimension());
+    if (columns <= points_x && rows <= points_y)
+      return *this;
+
+    const size_t bins_x(std::min(columns, size_t(std::max(1u, points_x))));
+    const size_t bins_y(std::min(rows, size_t(std::max(1u, points_y))));
+    Array1D<double> x(bins_x), y(bins_y);
+    for (size_t b(0); b < bins_x; b++)
+      x[b] = axis_x().point((b*columns/bins_x + (b+1)*columns/bins_x - 1)/2);
+    for (size_t b(0); b < bins_y; b++)
+      y[b] = axis_y().point((b*rows/bins_y + (b+1)*rows/bins_y - 1)/2);
+    // the outer bins are placed on the boundary, so that the domain is preserved (cf. the 1D case)
+    if (bins_x > 1)
+      {
+	x[0] = axis_x().point(0);
+	x[bins_x-1] = axis_x().point(columns-1);
+      }
+    if (bins_y > 1)
+      {
+	y[0] = axis_y().point(0);
+	y[bins_y-1] = axis_y().point(rows-1);
+      }
+
+    Array2D<C> values(bins_y, bins_x);
+    const size_t grain(std::max(size_t(1), sampled_mapping_grain*bins_x/(rows*columns)));
+    parallel_for(0, bins_x, [&](const size_t begin, const size_t end, const unsigned int)
+		 {
+		   // running minima, maxima and sums of the bins in one bin column
+		   Array1D<C> minima(bins_y), maxima(bins_y), sums(bins_y);
+		   for (size_t b_x(begin); b_x < end; b_x++)
+		     {
+		       const size_t column_begin(b_x*columns/bins_x), column_end((b_x+1)*columns/bins_x);
+		       for (size_t n(column_begin); n < column_end; n++)
+			 for (size_t b_y(0); b_y < bins_y; b_y++)
+			   {
+			     const size_t row_begin(b_y*rows/bins_y), row_end((b_y+1)*rows/bins_y);
+			     size_t m(row_begin);
+			     if (n == column_begin)
+			       {
+				 minima[b_y] = maxima[b_y] = sums[b_y] = values_(m,n);
+				 m++;
+			       }
+			     for (; m < row_end; m++)
+			       {
+				 const C v(values_(m,n));
+				 minima[b_y] = std::min(minima[b_y], v);
+				 maxima[b_y] = std::max(maxima[b_y], v);
+				 sums[b_y] += v;
+			       }
+			   }
+		       for (size_t b_y(0); b_y < bins_y; b_y++)
+			 {
+			   const size_t count((column_end-column_begin)
+					      * ((b_y+1)*rows/bins_y - b_y*rows/bins_y));
+			   const C mean(sums[b_y]/C(count));
+			   values(b_y, b_x) = maxima[b_y]-mean >= mean-minima[b_y] ? maxima[b_y] : minima[b_y];
+			 }
+		     }
+		 }, grain);
+    return SampledMapping<2,C>(Grid<2>(Grid<1>(x), Grid<1>(y)), values);
+  }
+
+  template <class C>
+  template <class FUNCTION>
+  void
+  SampledMapping<2,C>::sample(FUNCTION f)
+  {
+    const size_t rows(values_.row_dimension());
+    if (rows == 0)
+      return;
+    parallel_for(0, values_.column_dimension(),
+		 [&](const size_t begin, const size_t end, const unsigned int)
+		 {
+		   double xs[sampling_batch], ys[sampling_batch];
+		   for (size_t n(begin); n < end; n++)
+		     {
+		       C* v(&values_(0,n));
+		       std::fill(v+rows, v+values_.leading_dimension(), C());
+		       if constexpr (std::is_invocable_v<FUNCTION, double, double>)
+			 {
+			   if (is_tensor_product())
+			     {
+			       const double x_n(axis_x().point(n));
+			       for (size_t m(0); m < rows; m++)
+				 v[m] = f(x_n, axis_y().point(m));
+			     }
+			   else
+			     for (size_t m(0); m < rows; m++)
+			       v[m] = f(x(m,n), y(m,n));
+			 }
+		       else
+			 for (size_t m(0); m < rows; m += sampling_batch)
+			   {
+			     const size_t k(std::min(sampling_batch, rows-m));
+			     for (size_t j(0); j < k; j++)
+			       {
+				 xs[j] = x(m+j,n);
+				 ys[j] = y(m+j,n);
+			       }
+			     f(std::span<const double>(xs, k), std::span<const double>(ys, k),
+			       std::span<C>(v+m, k));
+			   }
+		     }
+		 }, std::max<size_t>(1, evaluation_grain/rows));
   }
 
   template <class C>
@@ -209,9 +793,9 @@ namespace AMSTeL
   {
     
     
-    for (int i = 0; i < gridy_.row_dimension(); i++) {
-      for (int j = 0; j < gridx_.column_dimension(); j++) {
-	os << gridx_(i,j) << "\t" << gridy_(i,j) << "\t" << values_(i,j) << endl;
+    for (unsigned int i = 0; i < row_dimension(); i++) {
+      for (unsigned int j = 0; j < column_dimension(); j++) {
+	os << x(i,j) << "\t" << y(i,j) << "\t" << values_(i,j) << std::endl;
       }
     }
   }
@@ -227,6 +811,482 @@ namespace AMSTeL
 //        << std::endl;
   }
 
+  template <class C>
+  bool
+  SampledMapping<2,C>::vtk_piece_output(std::ostream& os, const bool equidistant,
+					const size_t m0, const size_t m1,
+					const size_t n0, const size_t n1) const
+  {
+    const size_t rows(m1-m0+1), columns(n1-n0+1);
+    const std::uint64_t values_bytes(rows*columns*sizeof(C));
+    const std::streamsize old_precision = os.precision(17);
+
+    vtk_header(os, equidistant ? "ImageData" : "StructuredGrid");
+    if (equidistant)
+      {
+	// VTK's i axis points into y direction, j into x direction
+	const size_t M(row_dimension()), N(column_dimension());
+	os << "  <ImageData WholeExtent=\"";
+	vtk_extent(os, m0, m1, n0, n1);
+	os << "\" Origin=\"" << x(0,0) << " " << y(0,0) << " 0"
+	   << "\" Spacing=\"" << (y(M-1,0)-y(0,0))/(M-1)
+	   << " " << (x(0,N-1)-x(0,0))/(N-1) << " 1"
+	   << "\" Direction=\"0 1 0 1 0 0 0 0 1\">" << std::endl;
+      }
+    else
+      {
+	os << "  <StructuredGrid WholeExtent=\"";
+	vtk_extent(os, m0, m1, n0, n1);
+	os << "\">" << std::endl;
+      }
+    os << "    <Piece Extent=\"";
+    vtk_extent(os, m0, m1, n0, n1);
+    os << "\">" << std::endl
+       << "      <PointData Scalars=\"values\">" << std::endl
+       << "        <DataArray type=\"" << vtk_type_name<C>()
+       << "\" Name=\"values\" format=\"appended\" offset=\"0\"/>" << std::endl
+       << "      </PointData>" << std::endl;
+    if (!equidistant)
+      os << "      <Points>" << std::endl
+	 << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\""
+	 << sizeof(std::uint64_t) + values_bytes << "\"/>" << std::endl
+	 << "      </Points>" << std::endl;
+    os << "    </Piece>" << std::endl
+       << (equidistant ? "  </ImageData>" : "  </StructuredGrid>") << std::endl
+       << "  <AppendedData encoding=\"raw\">" << std::endl
+       << "_";
+
+    // the column segments of values_ are contiguous and can be written directly
+    vtk_block_size(os, values_bytes);
+    for (size_t n(n0); n <= n1; n++)
+      os.write(reinterpret_cast<const char*>(&values_(m0,n)), rows*sizeof(C));
+
+    if (!equidistant)
+      {
+	// interleave the point coordinates column by column
+	vtk_block_size(os, 3*rows*columns*sizeof(double));
+	Array1D<double> points(3*rows);
+	for (size_t n(n0); n <= n1; n++)
+	  {
+	    for (size_t m(m0), k(0); m <= m1; m++, k += 3)
+	      {
+		points[k]   = x(m,n);
+		points[k+1] = y(m,n);
+		points[k+2] = 0;
+	      }
+	    os.write(reinterpret_cast<const char*>(points.begin()), 3*rows*sizeof(double));
+	  }
+      }
+
+    os << std::endl
+       << "  </AppendedData>" << std::endl
+       << "</VTKFile>" << std::endl;
+    os.precision(old_precision);
+    return !os.fail();
+  }
+
+  template <class C>
+  bool
+  SampledMapping<2,C>::vtk_output(std::ostream& os) const
+  {
+    assert(values_.size() > 0);
+    return vtk_piece_output(os, is_equidistant(),
+		     0, values_.row_dimension()-1,
+		     0, values_.column_dimension()-1);
+  }
+
+  template <class C>
+  std::string
+  SampledMapping<2,C>::vtk_output(const std::string& filename_base,
+				  const unsigned int pieces_x,
+				  const unsigned int pieces_y) const
+  {
+    assert(values_.size() > 0);
+
+    const bool equidistant(is_equidistant());
+    const std::string extension(equidistant ? "vti" : "vts");
+    const size_t M(values_.row_dimension()), N(values_.column_dimension());
+
+    // each piece needs at least one cell, neighboring pieces share their boundary points
+    const unsigned int pm(std::max<size_t>(1, std::min<size_t>(pieces_y, M-1)));
+    const unsigned int pn(std::max<size_t>(1, std::min<size_t>(pieces_x, N-1)));
+
+    if (pm*pn == 1)
+      {
+	const std::string filename(filename_base + "." + extension);
+	std::ofstream ofs(filename.c_str(), std::ios::out | std::ios::binary);
+	if (!ofs.is_open() || !vtk_output(ofs))
+	  return std::string();
+	ofs.close();
+	return ofs.fail() ? std::string() : filename;
+      }
+
+    // write the pieces in parallel
+    const std::string piece_base
+      (std::filesystem::path(filename_base).filename().string());
+    std::vector<char> written(pm*pn, 0);
+    parallel_for(0, pm*pn,
+		 [&](const size_t begin, const size_t end, const unsigned int)
+		 {
+		   for (size_t piece(begin); piece < end; piece++)
+		     {
+		       size_t m0, m1, n0, n1;
+		       chunk_bounds(0, M-1, piece % pm, pm, m0, m1);
+		       chunk_bounds(0, N-1, piece / pm, pn, n0, n1);
+		       std::ostringstream filename;
+		       filename << filename_base << "_" << piece << "." << extension;
+		       std::ofstream ofs(filename.str().c_str(), std::ios::out | std::ios::binary);
+		       if (ofs.is_open() && vtk_piece_output(ofs, equidistant, m0, m1, n0, n1))
+			 {
+			   ofs.close();
+			   written[piece] = !ofs.fail();
+			 }
+		     }
+		 });
+    if (std::find(written.begin(), written.end(), 0) != written.end())
+      return std::string();
+
+    // index file
+    const std::string filename(filename_base + ".p" + extension);
+    std::ofstream ofs(filename.c_str());
+    ofs.precision(17);
+    if (equidistant)
+      {
+	vtk_header(ofs, "PImageData");
+	ofs << "  <PImageData WholeExtent=\"";
+	vtk_extent(ofs, 0, M-1, 0, N-1);
+	ofs << "\" GhostLevel=\"0\" Origin=\"" << x(0,0) << " " << y(0,0) << " 0"
+	    << "\" Spacing=\"" << (y(M-1,0)-y(0,0))/(M-1)
+	    << " " << (x(0,N-1)-x(0,0))/(N-1) << " 1"
+	    << "\" Direction=\"0 1 0 1 0 0 0 0 1\">" << std::endl;
+      }
+    else
+      {
+	vtk_header(ofs, "PStructuredGrid");
+	ofs << "  <PStructuredGrid WholeExtent=\"";
+	vtk_extent(ofs, 0, M-1, 0, N-1);
+	ofs << "\" GhostLevel=\"0\">" << std::endl;
+      }
+    ofs << "    <PPointData Scalars=\"values\">" << std::endl
+	<< "      <PDataArray type=\"" << vtk_type_name<C>() << "\" Name=\"values\"/>" << std::endl
+	<< "    </PPointData>" << std::endl;
+    if (!equidistant)
+      ofs << "    <PPoints>" << std::endl
+	  << "      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>" << std::endl
+	  << "    </PPoints>" << std::endl;
+    for (unsigned int piece(0); piece < pm*pn; piece++)
+      {
+	size_t m0, m1, n0, n1;
+	chunk_bounds(0, M-1, piece % pm, pm, m0, m1);
+	chunk_bounds(0, N-1, piece / pm, pn, n0, n1);
+	ofs << "    <Piece Extent=\"";
+	vtk_extent(ofs, m0, m1, n0, n1);
+	ofs << "\" Source=\"" << piece_base << "_" << piece << "." << extension << "\"/>" << std::endl;
+      }
+    ofs << (equidistant ? "  </PImageData>" : "  </PStructuredGrid>") << std::endl
+	<< "</VTKFile>" << std::endl;
+    ofs.close();
+
+    return ofs.fail() ? std::string() : filename;
+  }
+
+  template <unsigned int DIM, class C>
+  SampledMapping<DIM,C>::SampledMapping()
+    : Grid<DIM>(), values_()
+  {
+  }
+
+  template <unsigned int DIM, class C>
+  SampledMapping<DIM,C>::SampledMapping(const SampledMapping<DIM,C>& sm)
+    : Grid<DIM>(sm), values_(sm.values_)
+  {
+  }
+
+  template <unsigned int DIM, class C>
+  SampledMapping<DIM,C>::SampledMapping(SampledMapping<DIM,C>&& sm) noexcept
+    : Grid<DIM>(std::move(sm)), values_(std::move(sm.values_))
+  {
+  }
+
+  template <unsigned int DIM, class C>
+  SampledMapping<DIM,C>::SampledMapping(const Grid<DIM>& grid)
+    : Grid<DIM>(grid), values_(grid.size(), first_touch)
+  {
+  }
+
+  template <unsigned int DIM, class C>
+  SampledMapping<DIM,C>::SampledMapping(const Grid<DIM>& grid, const Array1D<C>& values)
+    : Grid<DIM>(grid), values_(values)
+  {
+    assert(values_.size() == grid.size());
+  }
+
+  template <unsigned int DIM, class C>
+  SampledMapping<DIM,C>&
+  SampledMapping<DIM,C>::operator = (const SampledMapping<DIM,C>& sm)
+  {
+    Grid<DIM>::operator = (sm);
+    values_ = sm.values_;
+    return *this;
+  }
+
+  template <unsigned int DIM, class C>
+  SampledMapping<DIM,C>&
+  SampledMapping<DIM,C>::operator = (SampledMapping<DIM,C>&& sm) noexcept
+  {
+    Grid<DIM>::operator = (std::move(sm));
+    values_ = std::move(sm.values_);
+    return *this;
+  }
+
+  template <unsigned int DIM, class C>
+  void
+  SampledMapping<DIM,C>::add(const SampledMapping<DIM,C>& s)
+  {
+    assert(values_.size() == s.values_.size());
+    assert(Grid<DIM>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] += x[i]; },
+		  sampled_mapping_grain);
+  }
+
+  template <unsigned int DIM, class C>
+  void
+  SampledMapping<DIM,C>::add(const C alpha, const SampledMapping<DIM,C>& s)
+  {
+    assert(values_.size() == s.values_.size());
+    assert(Grid<DIM>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] += alpha*x[i]; },
+		  sampled_mapping_grain);
+  }
+
+  template <unsigned int DIM, class C>
+  void
+  SampledMapping<DIM,C>::mult(const C alpha)
+  {
+    C* y(values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] *= alpha; },
+		  sampled_mapping_grain);
+  }
+
+  template <unsigned int DIM, class C>
+  void
+  SampledMapping<DIM,C>::axpby(const C alpha, const SampledMapping<DIM,C>& s, const C beta)
+  {
+    assert(values_.size() == s.values_.size());
+    assert(Grid<DIM>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] = alpha*x[i] + beta*y[i]; },
+		  sampled_mapping_grain);
+  }
+
+  template <unsigned int DIM, class C>
+  void
+  SampledMapping<DIM,C>::add(const C alpha, const SampledMapping<DIM,C>& s,
+	      const C beta, const SampledMapping<DIM,C>& t)
+  {
+    assert(values_.size() == s.values_.size() && values_.size() == t.values_.size());
+    assert(Grid<DIM>::same_grid(s) && Grid<DIM>::same_grid(t));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    const C* z(t.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] += alpha*x[i] + beta*z[i]; },
+		  sampled_mapping_grain);
+  }
+
+  template <unsigned int DIM, class C>
+  void
+  SampledMapping<DIM,C>::multiply(const SampledMapping<DIM,C>& s)
+  {
+    assert(values_.size() == s.values_.size());
+    assert(Grid<DIM>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] *= x[i]; },
+		  sampled_mapping_grain);
+  }
+
+  template <unsigned int DIM, class C>
+  template <class FUNCTION>
+  void
+  SampledMapping<DIM,C>::apply(FUNCTION f)
+  {
+    C* y(values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] = f(y[i]); },
+		  sampled_mapping_grain);
+  }
+
+  template <unsigned int DIM, class C>
+  template <class FUNCTION>
+  void
+  SampledMapping<DIM,C>::apply(FUNCTION f, const SampledMapping<DIM,C>& s)
+  {
+    assert(values_.size() == s.values_.size());
+    assert(Grid<DIM>::same_grid(s));
+    C* y(values_.begin());
+    const C* x(s.values_.begin());
+    parallel_loop(0, values_.size(), [=](const size_t i) { y[i] = f(y[i], x[i]); },
+		  sampled_mapping_grain);
+  }
+
+  template <unsigned int DIM, class C>
+  SampledMapping<DIM-1,C>
+  SampledMapping<DIM,C>::slice(const unsigned int k) const
+  {
+    assert(k < Grid<DIM>::slices());
+
+    const size_t slice_size(values_.size() / Grid<DIM>::slices());
+    const C* v(values_.begin() + k*slice_size);
+    if constexpr (DIM == 3)
+      {
+	// SampledMapping<2> expects the x direction in the columns
+	const unsigned int N0(Grid<DIM>::dimension(0)), N1(Grid<DIM>::dimension(1));
+	Array2D<C> plane(N1, N0);
+	for (unsigned int n(0); n < N0; n++)
+	  for (unsigned int m(0); m < N1; m++)
+	    plane(m,n) = v[n+m*N0];
+	return SampledMapping<2,C>(Grid<DIM>::slice_grid(), plane);
+      }
+    else
+      {
+	Array1D<C> values(slice_size, no_initialization);
+	std::copy(v, v+slice_size, values.begin());
+	return SampledMapping<DIM-1,C>(Grid<DIM>::slice_grid(), values);
+      }
+  }
+
+  template <unsigned int DIM, class C>
+  void
+  SampledMapping<DIM,C>::matlab_output(std::ostream& os,
+				       bool add_plot_command) const
+  {
+    Grid<DIM>::matlab_output(os);
+    os << "v = reshape(" << values_ << ",[";
+    for (unsigned int k(0); k < DIM; k++)
+      os << (k > 0 ? " " : "") << Grid<DIM>::dimension(k);
+    os << "]);" << std::endl;
+
+    if (add_plot_command && DIM == 3)
+      {
+	// slice() expects meshgrid arrays, i.e., the first two dimensions swapped
+	os << "p = [2 1 3];" << std::endl
+	   << "slice(permute(x1,p),permute(x2,p),permute(x3,p),permute(v,p)";
+	for (unsigned int k(0); k < DIM; k++)
+	  {
+	    const Grid<1>& axis(Grid<DIM>::axis(k));
+	    os << "," << (axis.point(0)+axis.point(axis.size()-1))/2;
+	  }
+	os << ")\n" << std::endl;
+      }
+  }
+
+  /*
+    VTK XML output of a 3D volume, where plane(k) yields the values
+    of the k-th slice (contiguous, first index running fastest)
+  */
+  template <class C, class PLANE>
+  void vtk_volume_output(std::ostream& os, const Grid<3>& grid, PLANE plane)
+  {
+    assert(grid.size() > 0);
+
+    const size_t N0(grid.dimension(0)), N1(grid.dimension(1)), N2(grid.dimension(2));
+    const bool equidistant(grid.is_equidistant());
+    const std::uint64_t slice_bytes(N0*N1*sizeof(C)), values_bytes(N2*slice_bytes);
+    const std::streamsize old_precision = os.precision(17);
+
+    vtk_header(os, equidistant ? "ImageData" : "RectilinearGrid");
+    os << (equidistant ? "  <ImageData WholeExtent=\"" : "  <RectilinearGrid WholeExtent=\"");
+    vtk_extent(os, 0, N0-1, 0, N1-1, 0, N2-1);
+    if (equidistant)
+      {
+	os << "\" Origin=\"";
+	for (unsigned int k(0); k < 3; k++)
+	  os << (k > 0 ? " " : "") << grid.axis(k).point(0);
+	os << "\" Spacing=\"";
+	for (unsigned int k(0); k < 3; k++)
+	  {
+	    const unsigned int N(grid.dimension(k));
+	    os << (k > 0 ? " " : "")
+	       << (N > 1 ? (grid.axis(k).point(N-1)-grid.axis(k).point(0))/(N-1) : 1.0);
+	  }
+      }
+    os << "\">" << std::endl
+       << "    <Piece Extent=\"";
+    vtk_extent(os, 0, N0-1, 0, N1-1, 0, N2-1);
+    os << "\">" << std::endl
+       << "      <PointData Scalars=\"values\">" << std::endl
+       << "        <DataArray type=\"" << vtk_type_name<C>()
+       << "\" Name=\"values\" format=\"appended\" offset=\"0\"/>" << std::endl
+       << "      </PointData>" << std::endl;
+    if (!equidistant)
+      {
+	// only the three axes are written
+	std::uint64_t offset(sizeof(std::uint64_t) + values_bytes);
+	os << "      <Coordinates>" << std::endl;
+	for (unsigned int k(0); k < 3; k++)
+	  {
+	    os << "        <DataArray type=\"Float64\" Name=\"" << "xyz"[k]
+	       << "\" format=\"appended\" offset=\"" << offset << "\"/>" << std::endl;
+	    offset += sizeof(std::uint64_t) + grid.dimension(k)*sizeof(double);
+	  }
+	os << "      </Coordinates>" << std::endl;
+      }
+    os << "    </Piece>" << std::endl
+       << (equidistant ? "  </ImageData>" : "  </RectilinearGrid>") << std::endl
+       << "  <AppendedData encoding=\"raw\">" << std::endl
+       << "_";
+
+    vtk_block_size(os, values_bytes);
+    for (size_t k(0); k < N2; k++)
+      os.write(reinterpret_cast<const char*>(plane(k)), slice_bytes);
+
+    if (!equidistant)
+      for (unsigned int k(0); k < 3; k++)
+	{
+	  const Array1D<double> points(grid.axis(k).points());
+	  vtk_block_size(os, points.size()*sizeof(double));
+	  os.write(reinterpret_cast<const char*>(points.begin()), points.size()*sizeof(double));
+	}
+
+    os << std::endl
+       << "  </AppendedData>" << std::endl
+       << "</VTKFile>" << std::endl;
+    os.precision(old_precision);
+  }
+
+  template <unsigned int DIM, class C>
+  void
+  SampledMapping<DIM,C>::vtk_output(std::ostream& os) const requires (DIM == 3)
+  {
+    const size_t slice_size(Grid<DIM>::dimension(0)*Grid<DIM>::dimension(1));
+    vtk_volume_output<C>(os, *this,
+			 [&](const size_t k) -> const C*
+			 {
+			   return values_.begin() + k*slice_size;
+			 });
+  }
+
+  template <class C, class SLICE>
+  void vtk_slice_output(std::ostream& os, const Grid<3>& grid, SLICE slice)
+  {
+    const unsigned int N0(grid.dimension(0)), N1(grid.dimension(1));
+    Array2D<C> plane(N1, N0);
+    Array1D<C> buffer(N0*N1, no_initialization);
+    vtk_volume_output<C>(os, grid,
+			 [&](const size_t k) -> const C*
+			 {
+			   slice(k, plane);
+			   for (unsigned int m(0); m < N1; m++)
+			     for (unsigned int n(0); n < N0; n++)
+			       buffer[n+m*N0] = plane(m,n);
+			   return buffer.begin();
+			 });
+  }
+
   template <unsigned int DIM, class C>
   void matlab_output(std::ostream& os,
 		     const SampledMapping<DIM,C>& sm)
@@ -14,6 +14,9 @@
 
 #include <iostream>
 #include <cmath>
+#include <string>
+#include <span>
+#include <type_traits>
 
 #include <geometry/grid.h>
 #include <utils/array1d.h>
@@ -23,9 +26,25 @@
 namespace AMSTeL
 {
   /*!
-    Abstract base class for a mapping from R^n to R,
+    interpolation schemes for the evaluation of sampled mappings:
+    piecewise (bi)linear, or piecewise (bi)cubic, i.e., local Lagrange interpolation
+    through the 4 (4x4) nearest grid points
+  */
+  enum class interpolation { linear, cubic };
+
+  /*!
+    Base class for a mapping from R^n to R,
     represented by finite many samples on a rectangular grid (Matlab style).
-    Meaningful values for n are n=1 and n=2 so far (see specializations).
+    For n=1 and n=2, there are specializations (see below).
+    In higher dimensions, the grid is a tensor product Grid<DIM>, and the values
+    are stored contiguously, with the first index running fastest, so that each
+    slice (the samples with fixed last index) is a contiguous block.
+    In all dimensions, the pointwise operations (add(), mult(), axpby(), apply(), ...)
+    run over the contiguous value storage; they are written such that the compiler
+    can vectorize them, and large mappings are split over number_of_threads() threads.
+    Copies of a mapping share the (immutable) grid points, only the values are
+    copied, and binary operations on mappings over a shared grid need no pointwise
+    comparison of the grids (cf. Grid<1>::shares_grid()).
   */
   template <unsigned int DIM, class C=double>
   class SampledMapping
@@ -35,12 +54,17 @@ namespace AMSTeL
     /*!
       default constructor, yields empty mapping
     */
-    SampledMapping() {}
+    SampledMapping();
 
     /*!
       copy constructor
     */
-    SampledMapping(const SampledMapping<DIM>& sm);
+    SampledMapping(const SampledMapping<DIM,C>& sm);
+
+    /*!
+      move constructor
+    */
+    SampledMapping(SampledMapping<DIM,C>&& sm) noexcept;
 
     /*!
       constructor from a given grid, yields zero function
@@ -49,6 +73,7 @@ namespace AMSTeL
 
     /*!
       constructor from a given grid and given values
+      (in the order of the grid points, first index running fastest)
     */
     SampledMapping(const Grid<DIM>& grid, const Array1D<C>& values);
 
@@ -57,6 +82,11 @@ namespace AMSTeL
     */
     SampledMapping<DIM,C>& operator = (const SampledMapping<DIM,C>& sm);
 
+    /*!
+      move assignment
+    */
+    SampledMapping<DIM,C>& operator = (SampledMapping<DIM,C>&& sm) noexcept;
+
     /*!
       pointwise in-place summation *this += s
       of two sampled mappings over the same grid
@@ -74,13 +104,79 @@ namespace AMSTeL
     */
     void mult(const C alpha);
 
+    /*!
+      in-place linear combination *this = alpha*s + beta*(*this)
+      of two sampled mappings over the same grid
+    */
+    void axpby(const C alpha, const SampledMapping<DIM,C>& s, const C beta);
+
+    /*!
+      fused in-place summation *this += alpha*s + beta*t
+      of three sampled mappings over the same grid
+    */
+    void add(const C alpha, const SampledMapping<DIM,C>& s,
+	     const C beta, const SampledMapping<DIM,C>& t);
+
+    /*!
+      pointwise in-place multiplication *this *= s
+      of two sampled mappings over the same grid
+    */
+    void multiply(const SampledMapping<DIM,C>& s);
+
+    /*!
+      pointwise in-place application of a function, x = f(x) for all values x
+    */
+    template <class FUNCTION>
+    void apply(FUNCTION f);
+
+    /*!
+      pointwise in-place application of a binary function, x = f(x,y) for all
+      values x and the corresponding values y of a sampled mapping over the same grid
+    */
+    template <class FUNCTION>
+    void apply(FUNCTION f, const SampledMapping<DIM,C>& s);
+
+    /*!
+      reading access to the function values
+    */
+    inline const Array1D<C>& values() const { return values_; }
+
+    /*!
+      the restriction to the k-th slice, as a (DIM-1)-dimensional sampled mapping
+    */
+    SampledMapping<DIM-1,C> slice(const unsigned int k) const;
 
     /*!
       Matlab output of the sampled mapping onto a stream
+      (the values are reshaped to a DIM-dimensional array v; the plot command
+      shows three orthogonal slices through the center for DIM == 3,
+      and it is ignored for DIM > 3)
     */
     void matlab_output(std::ostream& os,
 		       bool add_plot_command = false) const;
-    };
+
+    /*!
+      VTK XML output of a 3D sampled mapping onto a (binary) stream, with raw
+      appended data: ImageData (.vti) for equidistant grids, RectilinearGrid (.vtr)
+      otherwise; the values are written slice by slice
+    */
+    void vtk_output(std::ostream& os) const requires (DIM == 3);
+
+  protected:
+    /*!
+      internal storage for the function values
+    */
+    Array1D<C> values_;
+  };
+
+  /*!
+    VTK XML output of a 3D volume which is produced slice by slice, so that
+    only a single slice has to be held in memory: slice(k, plane) has to fill
+    the values of the k-th slice (plane(m,n) at the point (x_n, y_m, z_k),
+    as for SampledMapping<2>). The format is the same as for SampledMapping<3,C>::vtk_output().
+  */
+  template <class C, class SLICE>
+  void vtk_slice_output(std::ostream& os, const Grid<3>& grid, SLICE slice);
 
   //
   //
@@ -101,6 +197,11 @@ namespace AMSTeL
     */
     SampledMapping(const SampledMapping<1,C>& sm);
 
+    /*!
+      move constructor
+    */
+    SampledMapping(SampledMapping<1,C>&& sm) noexcept;
+
     /*!
       constructor from a given grid, yields zero function
     */
@@ -111,8 +212,18 @@ namespace AMSTeL
     */
     SampledMapping(const Grid<1>& grid, const Array1D<C>& values);
 
+    /*!
+      constructor from a given grid and a function f (cf. sample()),
+      the values are computed in parallel directly into the mapping
+    */
+    template <class FUNCTION>
+    requires std::is_invocable_v<FUNCTION, double>
+      || std::is_invocable_v<FUNCTION, std::span<const double>, std::span<C> >
+    SampledMapping(const Grid<1>& grid, FUNCTION f);
+
     /*!
       constructor from given values on 2^{-resolution}\mathbb Z, clipped to [a,b]
+      (linear in the number of grid points and of entries in the range)
     */
     SampledMapping(const int a,
 		   const int b,
@@ -124,6 +235,11 @@ namespace AMSTeL
     */
     SampledMapping<1,C>& operator = (const SampledMapping<1,C>& sm);
 
+    /*!
+      move assignment
+    */
+    SampledMapping<1,C>& operator = (SampledMapping<1,C>&& sm) noexcept;
+
     /*!
       pointwise in-place summation *this += s
       of two sampled mappings over the same grid
@@ -141,6 +257,74 @@ namespace AMSTeL
     */
     void mult(const C alpha);
 
+    /*!
+      in-place linear combination *this = alpha*s + beta*(*this)
+      of two sampled mappings over the same grid
+    */
+    void axpby(const C alpha, const SampledMapping<1,C>& s, const C beta);
+
+    /*!
+      fused in-place summation *this += alpha*s + beta*t
+      of three sampled mappings over the same grid
+    */
+    void add(const C alpha, const SampledMapping<1,C>& s,
+	     const C beta, const SampledMapping<1,C>& t);
+
+    /*!
+      pointwise in-place multiplication *this *= s
+      of two sampled mappings over the same grid
+    */
+    void multiply(const SampledMapping<1,C>& s);
+
+    /*!
+      pointwise in-place application of a function, x = f(x) for all values x
+    */
+    template <class FUNCTION>
+    void apply(FUNCTION f);
+
+    /*!
+      pointwise in-place application of a binary function, x = f(x,y) for all
+      values x and the corresponding values y of a sampled mapping over the same grid
+    */
+    template <class FUNCTION>
+    void apply(FUNCTION f, const SampledMapping<1,C>& s);
+
+    /*!
+      interpolated value at x (points outside the grid are extrapolated
+      from the boundary cells); the cell is found in O(1) on equidistant grids.
+      Throws std::invalid_argument for an empty grid.
+    */
+    C evaluate(const double x,
+	       const interpolation method = interpolation::linear) const;
+
+    /*!
+      batch evaluation values[i] = evaluate(points[i], method),
+      split over number_of_threads() threads for many points
+    */
+    void evaluate(const Array1D<double>& points, Array1D<C>& values,
+		  const interpolation method = interpolation::linear) const;
+
+    /*!
+      Level-of-detail reduction for plotting onto at most points values:
+      the first and the last grid point are kept, the interior points are split
+      into (points-2)/2 bins, and each bin is represented by its minimal and
+      maximal value (at their original positions), so that spikes remain visible.
+      Mappings with at most points values are returned unchanged,
+      for points < 2, only the first point (or nothing) is kept.
+      Only for real-valued mappings, one pass over the values.
+    */
+    SampledMapping<1,C> decimate(const unsigned int points) const;
+
+    /*!
+      Sample a function at the grid points, in parallel (f has to be thread-safe).
+      f is either a scalar function f(x), or a batched function f(x, values),
+      which is called for consecutive blocks of grid points with a span of the
+      coordinates and the span of the corresponding values to be written
+      (e.g., for user kernels which are vectorized over the points).
+    */
+    template <class FUNCTION>
+    void sample(FUNCTION f);
+
     /*!
       reading access to the function values
     */
@@ -179,6 +363,11 @@ namespace AMSTeL
     */
     SampledMapping(const SampledMapping<2,C>& sm);
 
+    /*!
+      move constructor
+    */
+    SampledMapping(SampledMapping<2,C>&& sm) noexcept;
+
     /*!
       constructor from a given grid, yields zero function
     */
@@ -190,11 +379,34 @@ namespace AMSTeL
     */
     SampledMapping(const Grid<2>& grid, const Array2D<C>& values);
 
+    /*!
+      constructor from a given grid and a function f (cf. sample()),
+      the values are computed in parallel directly into the mapping
+    */
+    template <class FUNCTION>
+    requires std::is_invocable_v<FUNCTION, double, double>
+      || std::is_invocable_v<FUNCTION, std::span<const double>, std::span<const double>, std::span<C> >
+    SampledMapping(const Grid<2>& grid, FUNCTION f);
+
+    /*!
+      constructor from given values on 2^{-resolution}\mathbb Z^2, clipped to
+      [a_1,b_1]x[a_2,b_2], where the first index component refers to the x direction
+      (linear in the number of grid points and of entries in the range)
+    */
+    SampledMapping(const int a_1, const int a_2, const int b_1, const int b_2,
+		   const InfiniteVector<C, std::pair<int,int> >& values,
+		   const int resolution);
+
     /*!
       assignment operator
     */
     SampledMapping<2,C>& operator = (const SampledMapping<2,C>& sm);
 
+    /*!
+      move assignment
+    */
+    SampledMapping<2,C>& operator = (SampledMapping<2,C>&& sm) noexcept;
+
     /*!
       pointwise in-place summation *this += s
       of two sampled mappings over the same grid
@@ -209,19 +421,92 @@ namespace AMSTeL
     
     /*!
      * add a matrix to the values_ of *this
+     * (an Array2D or a view, e.g., of a sub-block of a larger array)
     */
-    void add(const Array2D<C>& mat);
+    void add(const Array2DView<const C>& mat);
     
     /*!
      add alpha*mat to values_
+     (an Array2D or a view, e.g., of a sub-block of a larger array)
     */
-    void add(const C alpha, const Array2D<C>& mat);
+    void add(const C alpha, const Array2DView<const C>& mat);
 
     /*!
       pointwise in-place multiplication *this *= alpha
     */
     void mult(const C alpha);
 
+    /*!
+      in-place linear combination *this = alpha*s + beta*(*this)
+      of two sampled mappings over the same grid
+    */
+    void axpby(const C alpha, const SampledMapping<2,C>& s, const C beta);
+
+    /*!
+      fused in-place summation *this += alpha*s + beta*t
+      of three sampled mappings over the same grid
+    */
+    void add(const C alpha, const SampledMapping<2,C>& s,
+	     const C beta, const SampledMapping<2,C>& t);
+
+    /*!
+      pointwise in-place multiplication *this *= s
+      of two sampled mappings over the same grid
+    */
+    void multiply(const SampledMapping<2,C>& s);
+
+    /*!
+      pointwise in-place application of a function, x = f(x) for all values x
+    */
+    template <class FUNCTION>
+    void apply(FUNCTION f);
+
+    /*!
+      pointwise in-place application of a binary function, x = f(x,y) for all
+      values x and the corresponding values y of a sampled mapping over the same grid
+    */
+    template <class FUNCTION>
+    void apply(FUNCTION f, const SampledMapping<2,C>& s);
+
+    /*!
+      interpolated value at (x,y), only for tensor product grids
+      (cf. SampledMapping<1,C>::evaluate()); throws std::invalid_argument
+      for curvilinear or empty grids
+    */
+    C evaluate(const double x, const double y,
+	       const interpolation method = interpolation::linear) const;
+
+    /*!
+      batch evaluation values[i] = evaluate(x[i], y[i], method),
+      split over number_of_threads() threads for many points
+    */
+    void evaluate(const Array1D<double>& x, const Array1D<double>& y,
+		  Array1D<C>& values,
+		  const interpolation method = interpolation::linear) const;
+
+    /*!
+      Level-of-detail reduction for plotting onto at most points_x x points_y
+      bins (only for real-valued mappings on tensor product grids,
+      throws std::invalid_argument for curvilinear grids):
+      each bin is represented by its minimal or maximal value,
+      whichever deviates more from the bin average, so that spikes remain visible.
+      The bins lie at the centres of the grid blocks they represent, except for the
+      outer bins, which lie on the boundary of the grid, so that the domain is kept.
+      One pass over the values in storage order, split over the bin columns.
+    */
+    SampledMapping<2,C> decimate(const unsigned int points_x,
+				 const unsigned int points_y) const;
+
+    /*!
+      Sample a function at the grid points, in parallel over the columns
+      (f has to be thread-safe). f is either a scalar function f(x,y), or a batched
+      function f(x, y, values), which is called for consecutive blocks of a column
+      with spans of the coordinates and of the corresponding values to be written.
+      The padding of each column is cleared by the same thread.
+    */
+    template <class FUNCTION>
+    void sample(FUNCTION f);
+
     /*!
       reading access to the function values
     */
@@ -244,7 +529,35 @@ namespace AMSTeL
     */
     void octave_output(std::ostream& os) const;
 
+    /*!
+      VTK XML output of the sampled mapping onto a (binary) stream,
+      with raw appended data: ImageData (.vti) for equidistant grids,
+      StructuredGrid (.vts) otherwise; returns false if writing to the stream failed
+    */
+    bool vtk_output(std::ostream& os) const;
+
+    /*!
+      VTK XML output into files: for a single piece, filename_base.vti/.vts is written.
+      Otherwise, the grid is split into pieces_x*pieces_y tiles which are written in parallel
+      to filename_base_<k>.vti/.vts, together with an index file filename_base.pvti/.pvts.
+      Returns the name of the file to be opened in ParaView, or an empty string
+      if any of the files could not be written.
+    */
+    std::string vtk_output(const std::string& filename_base,
+			   const unsigned int pieces_x = 1,
+			   const unsigned int pieces_y = 1) const;
+
   protected:
+    /*!
+      VTK XML output of the sub-grid with row indices m0,...,m1 and column indices n0,...,n1
+      (VTK's i and j axes correspond to the rows and columns, respectively,
+      so that the values can be written directly from the column-major storage);
+      returns false if writing to the stream failed
+    */
+    bool vtk_piece_output(std::ostream& os, const bool equidistant,
+			  const size_t m0, const size_t m1,
+			  const size_t n0, const size_t n1) const;
+
     /*!
       internal storage for the function values
     */
@@ -0,0 +1,227 @@
+// implementation for sampled_mapping_norms.h
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <utils/array1d.h>
+#include <utils/parallel_for.h>
+
+namespace AMSTeL
+{
+  /*
+    minimal number of values per thread in the norm computations
+  */
+  inline constexpr size_t norms_grain(size_t(1)<<14);
+
+  /*
+    Neumaier's variant of Kahan summation: the rounding error of each
+    addition is accumulated separately and added at the end
+  */
+  struct CompensatedSum
+  {
+    double sum = 0;
+    double compensation = 0;
+
+    inline void add(const double x)
+    {
+      const double t(sum + x);
+      if (std::fabs(sum) >= std::fabs(x))
+	compensation += (sum - t) + x;
+      else
+	compensation += (x - t) + sum;
+      sum = t;
+    }
+
+    inline void add(const CompensatedSum& s)
+    {
+      add(s.sum);
+      compensation += s.compensation;
+    }
+
+    inline double value() const { return sum + compensation; }
+  };
+
+  /*
+    partial results of one chunk of a norm computation
+  */
+  struct PartialNorms
+  {
+    CompensatedSum l2, h1;
+    double linfty = 0;
+  };
+
+  /*
+    quadrature weights of the given rule for the points of a 1D grid
+  */
+  inline
+  Array1D<double>
+  quadrature_weights(const Grid<1>& grid, const quadrature_rule rule)
+  {
+    const unsigned int n(grid.size());
+    Array1D<double> w(n);
+    unsigned int i(0);
+    if (rule == quadrature_rule::simpson)
+      for (; i+2 < n; i += 2)
+	{
+	  const double h_0(grid.point(i+1)-grid.point(i)), h_1(grid.point(i+2)-grid.point(i+1));
+	  const double h(h_0+h_1);
+	  w[i]   += h/6 * (2-h_1/h_0);
+	  w[i+1] += h*h*h/(6*h_0*h_1);
+	  w[i+2] += h/6 * (2-h_0/h_1);
+	}
+    for (; i+1 < n; i++)
+      {
+	const double h(grid.point(i+1)-grid.point(i));
+	w[i]   += h/2;
+	w[i+1] += h/2;
+      }
+    return w;
+  }
+
+  /*
+    combine the partial results in chunk order
+  */
+  inline
+  DiscreteNorms
+  combine_norms(const std::vector<PartialNorms>& partials)
+  {
+    PartialNorms r;
+    for (const PartialNorms& p : partials)
+      {
+	r.l2.add(p.l2);
+	r.h1.add(p.h1);
+	r.linfty = std::max(r.linfty, p.linfty);
+      }
+    return DiscreteNorms{std::sqrt(std::max(r.l2.value(), 0.0)), r.linfty,
+			 std::sqrt(std::max(r.h1.value(), 0.0))};
+  }
+
+  /*
+    discrete norms of the mapping with values value(i) on a 1D grid
+  */
+  template <class VALUE>
+  DiscreteNorms
+  norms_kernel(const Grid<1>& grid, VALUE value, const quadrature_rule rule)
+  {
+    const size_t n(grid.size());
+    if (n == 0)
+      return DiscreteNorms{0, 0, 0};
+
+    const Array1D<double> weights(quadrature_weights(grid, rule));
+    const double* w(weights.begin());
+    std::vector<PartialNorms> partials(parallel_chunks(0, n, norms_grain));
+    parallel_for(0, n, [&](const size_t begin, const size_t end, const unsigned int chunk)
+		 {
+		   PartialNorms p;
+		   auto v(value(begin));
+		   for (size_t i(begin); i < end; i++)
+		     {
+		       const double a(std::abs(v));
+		       p.l2.add(w[i]*a*a);
+		       p.linfty = std::max(p.linfty, a);
+		       if (i+1 < n)
+			 {
+			   const auto v_next(value(i+1));
+			   const double d(std::abs(v_next-v));
+			   p.h1.add(d*d/(grid.point(i+1)-grid.point(i)));
+			   v = v_next;
+			 }
+		     }
+		   partials[chunk] = p;
+		 }, norms_grain);
+    return combine_norms(partials);
+  }
+
+  /*
+    discrete norms of the mapping with values value(m,n) on a 2D tensor product grid,
+    split over the columns
+  */
+  template <class VALUE>
+  DiscreteNorms
+  norms_kernel(const Grid<2>& grid, VALUE value, const quadrature_rule rule)
+  {
+    if (!grid.is_tensor_product())
+      throw std::invalid_argument("discrete norms need a tensor product grid");
+    const size_t rows(grid.row_dimension()), columns(grid.column_dimension());
+    if (rows == 0 || columns == 0)
+      return DiscreteNorms{0, 0, 0};
+
+    const Array1D<double> weights_x(quadrature_weights(grid.axis_x(), rule));
+    const Array1D<double> weights_y(quadrature_weights(grid.axis_y(), rule));
+    const double* w_x(weights_x.begin());
+    const double* w_y(weights_y.begin());
+    const size_t grain(std::max(size_t(1), norms_grain/rows));
+    std::vector<PartialNorms> partials(parallel_chunks(0, columns, grain));
+    parallel_for(0, columns, [&](const size_t begin, const size_t end, const unsigned int chunk)
+		 {
+		   PartialNorms p;
+		   for (size_t n(begin); n < end; n++)
+		     {
+		       const double h_x(n+1 < columns ? grid.axis_x().point(n+1)-grid.axis_x().point(n) : 0);
+		       for (size_t m(0); m < rows; m++)
+			 {
+			   const auto v(value(m,n));
+			   const double a(std::abs(v));
+			   p.l2.add(w_x[n]*w_y[m]*a*a);
+			   p.linfty = std::max(p.linfty, a);
+			   if (n+1 < columns)
+			     {
+			       const double d(std::abs(value(m,n+1)-v));
+			       p.h1.add(w_y[m]*d*d/h_x);
+			     }
+			   if (m+1 < rows)
+			     {
+			       const double d(std::abs(value(m+1,n)-v));
+			       p.h1.add(w_x[n]*d*d/(grid.axis_y().point(m+1)-grid.axis_y().point(m)));
+			     }
+			 }
+		     }
+		   partials[chunk] = p;
+		 }, grain);
+    return combine_norms(partials);
+  }
+
+  template <class C>
+  DiscreteNorms
+  discrete_norms(const SampledMapping<1,C>& f, const quadrature_rule rule)
+  {
+    const Array1D<C>& v(f.values());
+    return norms_kernel(static_cast<const Grid<1>&>(f),
+			[&](const size_t i) { return v[i]; }, rule);
+  }
+
+  template <class C>
+  DiscreteNorms
+  discrete_norms(const SampledMapping<2,C>& f, const quadrature_rule rule)
+  {
+    const Array2D<C>& v(f.values());
+    return norms_kernel(static_cast<const Grid<2>&>(f),
+			[&](const size_t m, const size_t n) { return v(m,n); }, rule);
+  }
+
+  template <class C>
+  DiscreteNorms
+  discrete_distances(const SampledMapping<1,C>& f, const SampledMapping<1,C>& g,
+		     const quadrature_rule rule)
+  {
+    assert(f.same_grid(g));
+    const Array1D<C>& v(f.values());
+    const Array1D<C>& w(g.values());
+    return norms_kernel(static_cast<const Grid<1>&>(f),
+			[&](const size_t i) { return v[i]-w[i]; }, rule);
+  }
+
+  template <class C>
+  DiscreteNorms
+  discrete_distances(const SampledMapping<2,C>& f, const SampledMapping<2,C>& g,
+		     const quadrature_rule rule)
+  {
+    assert(f.same_grid(g));
+    const Array2D<C>& v(f.values());
+    const Array2D<C>& w(g.values());
+    return norms_kernel(static_cast<const Grid<2>&>(f),
+			[&](const size_t m, const size_t n) { return v(m,n)-w(m,n); }, rule);
+  }
+}
@@ -0,0 +1,98 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_SAMPLED_MAPPING_NORMS_H
+#define _AMSTEL_SAMPLED_MAPPING_NORMS_H
+
+#include <geometry/grid.h>
+#include <geometry/sampled_mapping.h>
+
+namespace AMSTeL
+{
+  /*!
+    quadrature rules for the discrete L_2 norm of a sampled mapping:
+    the composite trapezoidal rule, or the composite Simpson rule on pairs
+    of neighbouring cells (for non-uniform grids, the 3-point rule with the
+    correct weights is used; for an odd number of cells, the last one is
+    treated with the trapezoidal rule)
+  */
+  enum class quadrature_rule { trapezoidal, simpson };
+
+  /*!
+    discrete norms of a sampled mapping f (or of the difference of two mappings):
+    - l2: L_2 norm, by quadrature of |f|^2 over the grid,
+    - linfty: maximum of |f| over the grid points,
+    - h1: H^1 seminorm of the piecewise (bi)linear interpolant, i.e.,
+      the L_2 norm of the finite difference gradient
+      (in 2D weighted with the quadrature rule in the transverse direction)
+  */
+  struct DiscreteNorms
+  {
+    double l2;
+    double linfty;
+    double h1;
+  };
+
+  /*!
+    Discrete norms of a sampled mapping, computed in one pass over the values,
+    split over number_of_threads() threads for large grids.
+    The sums are compensated (Kahan/Neumaier summation) and added in a fixed order,
+    so that the result is accurate and independent of the thread scheduling.
+    In 2D, only tensor product grids are supported (std::invalid_argument otherwise).
+  */
+  template <class C>
+  DiscreteNorms discrete_norms(const SampledMapping<1,C>& f,
+			       const quadrature_rule rule = quadrature_rule::trapezoidal);
+  template <class C>
+  DiscreteNorms discrete_norms(const SampledMapping<2,C>& f,
+			       const quadrature_rule rule = quadrature_rule::trapezoidal);
+
+  /*!
+    discrete norms of f-g for two sampled mappings over the same grid
+    (in one pass, without a temporary mapping)
+  */
+  template <class C>
+  DiscreteNorms discrete_distances(const SampledMapping<1,C>& f, const SampledMapping<1,C>& g,
+				   const quadrature_rule rule = quadrature_rule::trapezoidal);
+  template <class C>
+  DiscreteNorms discrete_distances(const SampledMapping<2,C>& f, const SampledMapping<2,C>& g,
+				   const quadrature_rule rule = quadrature_rule::trapezoidal);
+
+  /*!
+    shorthands for single norms (cf. discrete_norms())
+  */
+  template <class MAPPING>
+  inline double l2_norm(const MAPPING& f,
+			const quadrature_rule rule = quadrature_rule::trapezoidal)
+  { return discrete_norms(f, rule).l2; }
+  template <class MAPPING>
+  inline double linfty_norm(const MAPPING& f) { return discrete_norms(f).linfty; }
+  template <class MAPPING>
+  inline double h1_seminorm(const MAPPING& f) { return discrete_norms(f).h1; }
+
+  /*!
+    shorthands for single distances (cf. discrete_distances())
+  */
+  template <class MAPPING>
+  inline double l2_distance(const MAPPING& f, const MAPPING& g,
+			    const quadrature_rule rule = quadrature_rule::trapezoidal)
+  { return discrete_distances(f, g, rule).l2; }
+  template <class MAPPING>
+  inline double linfty_distance(const MAPPING& f, const MAPPING& g)
+  { return discrete_distances(f, g).linfty; }
+  template <class MAPPING>
+  inline double h1_semidistance(const MAPPING& f, const MAPPING& g)
+  { return discrete_distances(f, g).h1; }
+}
+
+#include <geometry/sampled_mapping_norms.cpp>
+
+#endif
@@ -0,0 +1,140 @@
+// implementation for checkpoint.h
+
+#include <cstdint>
+#include <type_traits>
+
+namespace AMSTeL
+{
+  template <class C, class I>
+  InfiniteVectorCheckpointWriter<C,I>::InfiniteVectorCheckpointWriter(std::ostream& os,
+                                                                      const unsigned int base_interval)
+    : os_(os), base_interval_(base_interval > 0 ? base_interval : 1), checkpoints_(0), marker_()
+  {
+    static_assert(std::is_trivially_copyable_v<C> && std::is_trivially_copyable_v<I>,
+                  "checkpoints require trivially copyable entries and indices");
+  }
+
+  template <class C, class I>
+  bool
+  InfiniteVectorCheckpointWriter<C,I>::write(const InfiniteVector<C,I>& v)
+  {
+    const bool base(checkpoints_ % base_interval_ == 0);
+
+    InfiniteVector<C,I> changed;
+    std::set<I> erased;
+    if (base)
+      changed = v;
+    else
+      v.delta(marker_, changed, erased);
+
+    // record format: tag ('B' for a base, 'D' for a delta),
+    // number of changed entries, number of erased entries,
+    // changed (index, value) pairs, erased indices
+    const char tag(base ? 'B' : 'D');
+    const std::uint64_t nchanged(changed.size()), nerased(erased.size());
+    os_.write(&tag, 1);
+    os_.write(reinterpret_cast<const char*>(&nchanged), sizeof(nchanged));
+    os_.write(reinterpret_cast<const char*>(&nerased), sizeof(nerased));
+    for (typename InfiniteVector<C,I>::const_iterator it(changed.begin()), itend(changed.end());
+         it != itend; ++it)
+      {
+        const I index(it.index());
+        const C value(it.value());
+        os_.write(reinterpret_cast<const char*>(&index), sizeof(I));
+        os_.write(reinterpret_cast<const char*>(&value), sizeof(C));
+      }
+    for (typename std::set<I>::const_iterator it(erased.begin()), itend(erased.end());
+         it != itend; ++it)
+      os_.write(reinterpret_cast<const char*>(&(*it)), sizeof(I));
+
+    // a truncated record must not become the reference for the next delta
+    if (!os_)
+      return false;
+
+    marker_ = v;
+    checkpoints_++;
+    return true;
+  }
+
+  template <class C, class I>
+  bool restore_checkpoint(std::istream& is,
+                          InfiniteVector<C,I>& v,
+                          const int checkpoint)
+  {
+    static_assert(std::is_trivially_copyable_v<C> && std::is_trivially_copyable_v<I>,
+                  "checkpoints require trivially copyable entries and indices");
+
+    v.clear();
+    int number(0);
+    char tag;
+
+    // on seekable streams, find the last base up to the requested checkpoint
+    // from the record headers, skipping the payloads
+    const std::streampos start(is.tellg());
+    if (start != std::streampos(-1))
+      {
+        std::streampos base(start);
+        int base_number(0);
+        while (checkpoint < 0 || number <= checkpoint)
+          {
+            const std::streampos position(is.tellg());
+            std::uint64_t nchanged, nerased;
+            if (!is.read(&tag, 1))
+              break;
+            if (!is.read(reinterpret_cast<char*>(&nchanged), sizeof(nchanged))
+                || !is.read(reinterpret_cast<char*>(&nerased), sizeof(nerased))
+                || (tag != 'B' && tag != 'D'))
+              return false;
+            if (tag == 'B')
+              {
+                base = position;
+                base_number = number;
+              }
+            if (!is.seekg(nchanged*(sizeof(I)+sizeof(C)) + nerased*sizeof(I), std::ios::cur))
+              return false;
+            number++;
+          }
+        if (checkpoint < 0 ? number == 0 : number != checkpoint+1)
+          return false;
+
+        is.clear();
+        is.seekg(base);
+        number = base_number;
+      }
+
+    while ((checkpoint < 0 || number <= checkpoint) && is.read(&tag, 1))
+      {
+        std::uint64_t nchanged, nerased;
+        if (!is.read(reinterpret_cast<char*>(&nchanged), sizeof(nchanged))
+            || !is.read(reinterpret_cast<char*>(&nerased), sizeof(nerased))
+            || (tag != 'B' && tag != 'D'))
+          return false;
+
+        InfiniteVector<C,I> changed;
+        std::set<I> erased;
+        I index;
+        C value;
+        for (std::uint64_t n(0); n < nchanged; n++)
+          {
+            if (!is.read(reinterpret_cast<char*>(&index), sizeof(I))
+                || !is.read(reinterpret_cast<char*>(&value), sizeof(C)))
+              return false;
+            changed.set_coefficient(index, value);
+          }
+        for (std::uint64_t n(0); n < nerased; n++)
+          {
+            if (!is.read(reinterpret_cast<char*>(&index), sizeof(I)))
+              return false;
+            erased.insert(erased.end(), index);
+          }
+
+        if (tag == 'B')
+          v.swap(changed);
+        else
+          v.apply_delta(changed, erased);
+        number++;
+      }
+
+    return checkpoint < 0 ? number > 0 : number == checkpoint+1;
+  }
+}
@@ -0,0 +1,94 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_CHECKPOINT_H
+#define _AMSTEL_CHECKPOINT_H
+
+#include <iostream>
+#include <set>
+#include <algebra/infinite_vector.h>
+
+namespace AMSTeL
+{
+  /*!
+    Incremental (differential) checkpoints of the iterates of an adaptive
+    solver, given as InfiniteVector<C,I> objects.
+
+    Every base_interval-th checkpoint is a full copy of the vector (a base),
+    all other checkpoints only store the delta to the previous checkpoint,
+    i.e., the inserted or modified entries and the indices of the erased entries
+    (cf. InfiniteVector::delta()). To this end, the writer keeps a copy of the
+    last checkpointed vector as a marker.
+
+    The checkpoints are written in a raw binary format onto a stream, which
+    should hence be opened with std::ios::binary. C and I have to be trivially
+    copyable types. A checkpoint sequence can be restored with restore_checkpoint().
+  */
+  template <class C, class I = int>
+  class InfiniteVectorCheckpointWriter
+  {
+  public:
+    /*!
+      constructor from an output stream and the distance between two full checkpoints
+    */
+    InfiniteVectorCheckpointWriter(std::ostream& os, const unsigned int base_interval = 10);
+
+    /*!
+      write a checkpoint of the vector v;
+      returns false if the stream could not take the whole record
+      (the checkpoint is not counted then, and the stream should be discarded)
+    */
+    bool write(const InfiniteVector<C,I>& v);
+
+    /*!
+      number of checkpoints written so far
+    */
+    inline unsigned int checkpoints() const { return checkpoints_; }
+
+  protected:
+    /*!
+      the output stream
+    */
+    std::ostream& os_;
+
+    /*!
+      distance between two full checkpoints
+    */
+    unsigned int base_interval_;
+
+    /*!
+      number of checkpoints written so far
+    */
+    unsigned int checkpoints_;
+
+    /*!
+      vector from the last checkpoint
+    */
+    InfiniteVector<C,I> marker_;
+  };
+
+  /*!
+    restore a vector from a stream written by InfiniteVectorCheckpointWriter,
+    by replaying the last base before the requested checkpoint plus all subsequent deltas;
+    a negative checkpoint number restores the last checkpoint.
+    On seekable streams, the records before that base are skipped without being read
+    (otherwise, all records from the current position are replayed).
+    Returns false if the stream does not contain the requested checkpoint.
+  */
+  template <class C, class I>
+  bool restore_checkpoint(std::istream& is,
+                          InfiniteVector<C,I>& v,
+                          const int checkpoint = -1);
+}
+
+#include "io/checkpoint.cpp"
+
+#endif
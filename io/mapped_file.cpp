@@ -0,0 +1,76 @@
+// implementation for mapped_file.h
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace AMSTeL
+{
+  inline
+  MappedFile::MappedFile()
+    : data_(0), size_(0), is_open_(false)
+  {
+  }
+
+  inline
+  MappedFile::MappedFile(const std::string& filename)
+    : data_(0), size_(0), is_open_(false)
+  {
+    open(filename);
+  }
+
+  inline
+  MappedFile::~MappedFile()
+  {
+    close();
+  }
+
+  inline
+  bool
+  MappedFile::open(const std::string& filename)
+  {
+    close();
+
+    const int fd(::open(filename.c_str(), O_RDONLY));
+    if (fd < 0)
+      return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+      {
+        ::close(fd);
+        return false;
+      }
+
+    size_ = info.st_size;
+    if (size_ > 0)
+      {
+        void* p(mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0));
+        if (p == MAP_FAILED)
+          {
+            ::close(fd);
+            size_ = 0;
+            return false;
+          }
+        data_ = static_cast<const char*>(p);
+        // the file is read front to back
+        madvise(p, size_, MADV_SEQUENTIAL);
+      }
+    ::close(fd); // the mapping stays valid
+
+    is_open_ = true;
+    return true;
+  }
+
+  inline
+  void
+  MappedFile::close()
+  {
+    if (data_ != 0)
+      munmap(const_cast<char*>(data_), size_);
+    data_ = 0;
+    size_ = 0;
+    is_open_ = false;
+  }
+}
@@ -0,0 +1,89 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_MAPPED_FILE_H
+#define _AMSTEL_MAPPED_FILE_H
+
+#include <string>
+
+namespace AMSTeL
+{
+  /*!
+    Read-only memory mapping of a file (POSIX mmap()).
+    The mapping is released by the destructor or by close().
+  */
+  class MappedFile
+  {
+  public:
+    /*!
+      default constructor, no file mapped
+    */
+    MappedFile();
+
+    /*!
+      map the given file into memory, check is_open() for success
+    */
+    explicit MappedFile(const std::string& filename);
+
+    /*!
+      release the mapping
+    */
+    ~MappedFile();
+
+    /*!
+      map the given file into memory (an existing mapping is released before)
+    */
+    bool open(const std::string& filename);
+
+    /*!
+      release the mapping
+    */
+    void close();
+
+    /*!
+      check whether a file is mapped
+    */
+    inline bool is_open() const { return is_open_; }
+
+    /*!
+      start of the file contents
+    */
+    inline const char* data() const { return data_; }
+
+    /*!
+      size of the file in bytes
+    */
+    inline size_t size() const { return size_; }
+
+  private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+
+    /*!
+      start of the mapped region (0 for empty files)
+    */
+    const char* data_;
+
+    /*!
+      size of the mapped region
+    */
+    size_t size_;
+
+    /*!
+      flag whether a file has been opened
+    */
+    bool is_open_;
+  };
+}
+
+#include "io/mapped_file.cpp"
+
+#endif
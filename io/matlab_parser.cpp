@@ -0,0 +1,140 @@
+// implementation for matlab_parser.h
+
+#include <algorithm>
+#include <charconv>
+#include <vector>
+#include <utils/parallel_for.h>
+
+namespace AMSTeL
+{
+  /*!
+    whitespace test for the Matlab parser
+  */
+  inline
+  bool matlab_whitespace(const char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  /*!
+    separator test for the Matlab parser (whitespace, entry and row separators)
+  */
+  inline
+  bool matlab_separator(const char c)
+  {
+    return matlab_whitespace(c) || c == ',' || c == ';';
+  }
+
+  template <class T, class ALLOCATE, class STORE>
+  bool parse_matlab_array(const char* first, const char* last,
+                          ALLOCATE allocate, STORE store,
+                          const bool consistent_rows)
+  {
+    const char* begin(std::find(first, last, '['));
+    if (begin == last)
+      return false;
+    const char* end(std::find(++begin, last, ']'));
+    if (end == last)
+      return false;
+
+    // a trailing row separator "[...;]" does not open a new row
+    const char* back(end);
+    while (back != begin && matlab_whitespace(back[-1])) --back;
+    if (back != begin && back[-1] == ';')
+      end = back-1;
+
+    // split the text into chunks, moving the chunk bounds to separator positions
+    // such that no entry is split
+    const size_t length(end-begin), grain(1<<20);
+    const unsigned int chunks(parallel_chunks(0, length, grain));
+    std::vector<const char*> bounds(chunks+1);
+    bounds[0] = begin;
+    bounds[chunks] = end;
+    for (unsigned int chunk(1); chunk < chunks; chunk++)
+      {
+        size_t chunk_begin, chunk_end;
+        chunk_bounds(0, length, chunk, chunks, chunk_begin, chunk_end);
+        const char* p(std::max(begin+chunk_begin, bounds[chunk-1]));
+        while (p != end && !matlab_separator(*p)) ++p;
+        bounds[chunk] = p;
+      }
+
+    // first pass: count the entries and row separators of each chunk
+    std::vector<size_t> entries(chunks+1, 0), separators(chunks+1, 0);
+    parallel_for(0, chunks,
+                 [&](const size_t chunk_begin, const size_t chunk_end, const unsigned int)
+                 {
+                   for (size_t chunk(chunk_begin); chunk < chunk_end; chunk++)
+                     {
+                       size_t n(0), s(0);
+                       bool separator(true);
+                       for (const char* p(bounds[chunk]); p != bounds[chunk+1]; ++p)
+                         {
+                           if (matlab_separator(*p))
+                             {
+                               separator = true;
+                               if (*p == ';') s++;
+                             }
+                           else
+                             {
+                               if (separator) n++;
+                               separator = false;
+                             }
+                         }
+                       entries[chunk+1] = n;
+                       separators[chunk+1] = s;
+                     }
+                 });
+    for (unsigned int chunk(1); chunk <= chunks; chunk++)
+      {
+        // prefix sums: offsets of the chunks
+        entries[chunk] += entries[chunk-1];
+        separators[chunk] += separators[chunk-1];
+      }
+
+    const size_t total(entries[chunks]);
+    const size_t rows(total == 0 && separators[chunks] == 0 ? 0 : separators[chunks]+1);
+    if (consistent_rows && rows > 0 && total % rows != 0)
+      return false;
+    const size_t columns(rows == 0 ? 0 : total / rows);
+
+    if (!allocate(rows, total))
+      return false;
+
+    // second pass: convert and store the entries
+    std::vector<char> success(chunks, 1);
+    parallel_for(0, chunks,
+                 [&](const size_t chunk_begin, const size_t chunk_end, const unsigned int)
+                 {
+                   for (size_t chunk(chunk_begin); chunk < chunk_end; chunk++)
+                     {
+                       size_t k(entries[chunk]), row(separators[chunk]);
+                       const char* p(bounds[chunk]);
+                       const char* chunk_last(bounds[chunk+1]);
+                       while (p != chunk_last)
+                         {
+                           if (matlab_separator(*p))
+                             {
+                               if (*p == ';') row++;
+                               ++p;
+                               continue;
+                             }
+                           const char* token_end(p);
+                           while (token_end != chunk_last && !matlab_separator(*token_end)) ++token_end;
+                           T value;
+                           const std::from_chars_result result(std::from_chars(p, token_end, value));
+                           if (result.ec != std::errc() || result.ptr != token_end
+                               || (consistent_rows && k / columns != row))
+                             {
+                               success[chunk] = 0;
+                               break;
+                             }
+                           store(k++, value);
+                           p = token_end;
+                         }
+                     }
+                 });
+
+    return std::find(success.begin(), success.end(), 0) == success.end();
+  }
+}
@@ -0,0 +1,50 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_MATLAB_PARSER_H
+#define _AMSTEL_MATLAB_PARSER_H
+
+#include <cstddef>
+
+namespace AMSTeL
+{
+  /*
+    Parser for Matlab-style array text of the form
+      [x_{1,1} x_{1,2} ... x_{1,n}; x_{2,1} ... x_{m,n}]
+    as written by print_vector() and print_matrix().
+    Anything before the opening bracket (like "x = ") and behind the
+    closing bracket (like ";") is ignored. Entries are separated by
+    whitespace or commas, rows by semicolons.
+
+    The parser runs in two passes over the text: the first one counts the entries
+    and rows, so that the target array can be allocated at once, the second one
+    converts the entries with std::from_chars() and stores them. Large inputs are
+    split into chunks at separator positions, and both passes process the chunks
+    in parallel.
+  */
+
+  /*!
+    Parse the Matlab-style array in [first,last) with entries of type T.
+    After the first pass, allocate(rows, entries) is called, it may return false
+    to reject the shape. Then store(k, value) is called for the k-th entry
+    (in row-wise order), for all k < entries.
+    For consistent_rows == true, all rows must have the same number of entries.
+    Returns false if the text is malformed.
+  */
+  template <class T, class ALLOCATE, class STORE>
+  bool parse_matlab_array(const char* first, const char* last,
+                          ALLOCATE allocate, STORE store,
+                          const bool consistent_rows = true);
+}
+
+#include "io/matlab_parser.cpp"
+
+#endif
@@ -14,6 +14,9 @@
 
 #include <iostream>
 #include <iomanip>
+#include <string>
+#include "io/matlab_parser.h"
+#include "io/mapped_file.h"
 
 using std::cout;
 using std::endl;
@@ -51,6 +54,40 @@ namespace AMSTeL
     os << "];" << std::endl;
     os.precision(old_precision);
   }
+
+  /*!
+    generic parser for Matlab-style matrices
+      [x_{1,1} x_{1,2} ... x_{1,n}; x_{2,1} ... x_{m,n}]
+    (as written by print_matrix()) in the text [first,last);
+    M is resized to the number of rows and columns, using resize(row,col).
+    Returns false if the text is malformed, the rows have different lengths
+    or M cannot be resized (e.g., a FixedArray2D of a different size).
+  */
+  template <class MATRIX>
+  bool read_matrix(const char* first, const char* last, MATRIX& M)
+  {
+    typedef typename MATRIX::value_type value_type;
+    size_t columns(0);
+    return parse_matlab_array<value_type>
+      (first, last,
+       [&M, &columns](const size_t rows, const size_t entries)
+       {
+         columns = (rows == 0 ? 0 : entries / rows);
+         M.resize(rows, columns);
+         return M.row_dimension() == rows && M.column_dimension() == columns;
+       },
+       [&M, &columns](const size_t k, const value_type& value) { M(k / columns, k % columns) = value; });
+  }
+
+  /*!
+    read a Matlab-style matrix from a (memory-mapped) file
+  */
+  template <class MATRIX>
+  bool read_matrix(const std::string& filename, MATRIX& M)
+  {
+    MappedFile file(filename);
+    return file.is_open() && read_matrix(file.data(), file.data()+file.size(), M);
+  }
 }
 
 #endif
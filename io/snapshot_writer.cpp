@@ -0,0 +1,156 @@
+// implementation for snapshot_writer.h
+
+#include <fstream>
+#include <algorithm>
+#include <optional>
+
+namespace AMSTeL
+{
+  template <class SNAPSHOT>
+  void snapshot_output(std::ostream& os, const SNAPSHOT& s)
+  {
+    if constexpr (requires { s.matlab_output(os); })
+      s.matlab_output(os);
+    else
+      os << s;
+  }
+
+  template <class SNAPSHOT>
+  SnapshotWriter<SNAPSHOT>::SnapshotWriter(const size_t capacity)
+    : SnapshotWriter(formatter_type(snapshot_output<SNAPSHOT>), capacity)
+  {
+  }
+
+  template <class SNAPSHOT>
+  SnapshotWriter<SNAPSHOT>::SnapshotWriter(const formatter_type& formatter, const size_t capacity)
+    : formatter_(formatter), capacity_(std::max<size_t>(capacity, 1)),
+      queue_(), active_(0), failures_(0), stop_(false)
+  {
+    thread_ = std::thread(&SnapshotWriter<SNAPSHOT>::run_, this);
+  }
+
+  template <class SNAPSHOT>
+  SnapshotWriter<SNAPSHOT>::~SnapshotWriter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    not_empty_.notify_one();
+    thread_.join();
+  }
+
+  template <class SNAPSHOT>
+  void
+  SnapshotWriter<SNAPSHOT>::write(SNAPSHOT&& snapshot, const std::string& filename)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_full_.wait(lock, [this] { return queue_.size() < capacity_; });
+      queue_.emplace_back(std::move(snapshot), filename);
+    }
+    not_empty_.notify_one();
+  }
+
+  template <class SNAPSHOT>
+  void
+  SnapshotWriter<SNAPSHOT>::write(const SNAPSHOT& snapshot, const std::string& filename)
+  {
+    // copy outside of the critical section
+    SNAPSHOT copy(snapshot);
+    write(std::move(copy), filename);
+  }
+
+  template <class SNAPSHOT>
+  bool
+  SnapshotWriter<SNAPSHOT>::try_write(SNAPSHOT&& snapshot, const std::string& filename)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.size() >= capacity_)
+        return false;
+      queue_.emplace_back(std::move(snapshot), filename);
+    }
+    not_empty_.notify_one();
+    return true;
+  }
+
+  template <class SNAPSHOT>
+  bool
+  SnapshotWriter<SNAPSHOT>::flush()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return queue_.empty() && active_ == 0; });
+    return failures_ == 0;
+  }
+
+  template <class SNAPSHOT>
+  size_t
+  SnapshotWriter<SNAPSHOT>::pending() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size() + active_;
+  }
+
+  template <class SNAPSHOT>
+  size_t
+  SnapshotWriter<SNAPSHOT>::failures() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failures_;
+  }
+
+  template <class SNAPSHOT>
+  void
+  SnapshotWriter<SNAPSHOT>::run_()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+      {
+        not_empty_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty())
+          break; // stop_ is set and all snapshots have been written
+
+        // the queue entry is removed in any case, so that the loop keeps draining
+        std::optional<std::pair<SNAPSHOT, std::string> > item;
+        try
+          {
+            item.emplace(std::move(queue_.front()));
+          }
+        catch (...)
+          {
+          }
+        queue_.pop_front();
+        active_ = 1;
+        lock.unlock();
+        not_full_.notify_one();
+
+        // format and write the snapshot without holding the lock,
+        // exceptions must not leave the thread (std::terminate)
+        bool success(false);
+        if (item)
+          try
+            {
+              std::ofstream ofs(item->second.c_str());
+              if (ofs.is_open())
+                {
+                  formatter_(ofs, item->first);
+                  ofs.close();
+                  success = !ofs.fail();
+                }
+            }
+          catch (...)
+            {
+              success = false;
+            }
+        item.reset();
+
+        lock.lock();
+        active_ = 0;
+        if (!success)
+          failures_++;
+        if (queue_.empty())
+          idle_.notify_all();
+      }
+  }
+}
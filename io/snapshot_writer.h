@@ -0,0 +1,160 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_SNAPSHOT_WRITER_H
+#define _AMSTEL_SNAPSHOT_WRITER_H
+
+#include <iostream>
+#include <string>
+#include <deque>
+#include <utility>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace AMSTeL
+{
+  /*!
+    default formatting routine for snapshots: objects with a Matlab output
+    routine (like SampledMapping) use it, all others are written via operator <<
+  */
+  template <class SNAPSHOT>
+  void snapshot_output(std::ostream& os, const SNAPSHOT& s);
+
+  /*!
+    Asynchronous writer for snapshots of a time-stepping or iterative loop,
+    e.g., SampledMapping or InfiniteVector objects.
+
+    The writer takes ownership of each snapshot (by move or by copy),
+    and a background thread formats it and writes it to a file.
+    Pending snapshots are kept in a bounded queue; the default capacity 2
+    corresponds to classical double buffering. Once the queue is full,
+    write() blocks until the background thread has caught up (back-pressure),
+    whereas try_write() returns immediately and leaves the snapshot untouched.
+
+    The destructor writes all pending snapshots before returning.
+    Exceptions thrown while formatting or writing a snapshot are caught on the
+    background thread; the snapshot counts as failed (cf. flush() and failures()).
+  */
+  template <class SNAPSHOT>
+  class SnapshotWriter
+  {
+  public:
+    /*!
+      type of the formatting routine, called on the background thread
+    */
+    typedef std::function<void(std::ostream&, const SNAPSHOT&)> formatter_type;
+
+    /*!
+      constructor with the default formatting routine snapshot_output()
+    */
+    explicit SnapshotWriter(const size_t capacity = 2);
+
+    /*!
+      constructor with a user-defined formatting routine
+    */
+    SnapshotWriter(const formatter_type& formatter, const size_t capacity = 2);
+
+    /*!
+      write all pending snapshots and stop the background thread
+    */
+    ~SnapshotWriter();
+
+    /*!
+      queue a snapshot for output to the given file, taking ownership of it;
+      blocks while the queue is full
+    */
+    void write(SNAPSHOT&& snapshot, const std::string& filename);
+
+    /*!
+      queue a copy of a snapshot for output to the given file;
+      blocks while the queue is full
+    */
+    void write(const SNAPSHOT& snapshot, const std::string& filename);
+
+    /*!
+      queue a snapshot if there is space left in the queue;
+      the snapshot is only moved from if true is returned
+    */
+    bool try_write(SNAPSHOT&& snapshot, const std::string& filename);
+
+    /*!
+      wait until all queued snapshots have been written,
+      returns false if any snapshot so far could not be written
+    */
+    bool flush();
+
+    /*!
+      number of snapshots which have been queued but not yet written
+    */
+    size_t pending() const;
+
+    /*!
+      number of snapshots which could not be written so far
+    */
+    size_t failures() const;
+
+  private:
+    SnapshotWriter(const SnapshotWriter<SNAPSHOT>&) = delete;
+    SnapshotWriter<SNAPSHOT>& operator = (const SnapshotWriter<SNAPSHOT>&) = delete;
+
+    /*!
+      main loop of the background thread
+    */
+    void run_();
+
+    /*!
+      formatting routine
+    */
+    formatter_type formatter_;
+
+    /*!
+      maximal number of pending snapshots
+    */
+    size_t capacity_;
+
+    /*!
+      queued snapshots together with their file names
+    */
+    std::deque<std::pair<SNAPSHOT, std::string> > queue_;
+
+    /*!
+      number of snapshots currently formatted by the background thread (0 or 1)
+    */
+    size_t active_;
+
+    /*!
+      number of failed writes
+    */
+    size_t failures_;
+
+    /*!
+      flag signalling the background thread to terminate
+    */
+    bool stop_;
+
+    /*!
+      synchronization of queue_, active_, failures_ and stop_
+    */
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_, not_full_, idle_;
+
+    /*!
+      background thread (started last, after all other members)
+    */
+    std::thread thread_;
+  };
+}
+
+#include "io/snapshot_writer.cpp"
+
+#endif
@@ -14,6 +14,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <string>
+#include "io/matlab_parser.h"
+#include "io/mapped_file.h"
 
 using std::cout;
 using std::endl;
@@ -42,6 +45,35 @@ namespace AMSTeL
         }
         os << "]";
     }
+
+    /*!
+     * generic parser for Matlab-style vectors [x_1 x_2 ... x_n]
+     * (as written by print_vector()) in the text [first,last);
+     * v is resized to the number of entries, which may also be separated
+     * by semicolons (column vectors).
+     * Returns false if the text is malformed or v cannot be resized
+     * (e.g., a FixedArray1D of a different size).
+     */
+    template <class VECTOR>
+    bool read_vector(const char* first, const char* last, VECTOR& v)
+    {
+        typedef typename VECTOR::value_type value_type;
+        return parse_matlab_array<value_type>
+            (first, last,
+             [&v](const size_t, const size_t entries) { v.resize(entries); return v.size() == entries; },
+             [&v](const size_t k, const value_type& value) { v[k] = value; },
+             false);
+    }
+
+    /*!
+     * read a Matlab-style vector from a (memory-mapped) file
+     */
+    template <class VECTOR>
+    bool read_vector(const std::string& filename, VECTOR& v)
+    {
+        MappedFile file(filename);
+        return file.is_open() && read_vector(file.data(), file.data()+file.size(), v);
+    }
   
 //   /* The following file IO routines are temporarily commented out... they have to be made independent of the VECTOR instance!
 
@@ -0,0 +1,94 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_VTK_IO_H
+#define _AMSTEL_VTK_IO_H
+
+#include <iostream>
+#include <cstdint>
+#include <bit>
+#include <type_traits>
+
+namespace AMSTeL
+{
+  /*
+    helper routines for the VTK XML file formats (.vti, .vts, .vtr, .pvti, .pvts)
+    with raw appended binary data, cf. "VTK File Formats" in the VTK user's guide
+  */
+
+  /*!
+    VTK name of a scalar type C (Float64, Int32, ...)
+  */
+  template <class C>
+  constexpr const char* vtk_type_name()
+  {
+    static_assert(std::is_arithmetic_v<C>, "VTK output requires arithmetic types");
+    if constexpr (std::is_floating_point_v<C>)
+      return sizeof(C) == 4 ? "Float32" : "Float64";
+    else if constexpr (std::is_signed_v<C>)
+      return sizeof(C) == 1 ? "Int8" : sizeof(C) == 2 ? "Int16" : sizeof(C) == 4 ? "Int32" : "Int64";
+    else
+      return sizeof(C) == 1 ? "UInt8" : sizeof(C) == 2 ? "UInt16" : sizeof(C) == 4 ? "UInt32" : "UInt64";
+  }
+
+  /*!
+    byte order of the host, as required by the VTKFile tag
+  */
+  constexpr const char* vtk_byte_order()
+  {
+    return std::endian::native == std::endian::little ? "LittleEndian" : "BigEndian";
+  }
+
+  /*!
+    write the opening VTKFile tag for a given dataset type (ImageData, PStructuredGrid, ...)
+  */
+  inline
+  void vtk_header(std::ostream& os, const char* type)
+  {
+    os << "<?xml version=\"1.0\"?>" << std::endl
+       << "<VTKFile type=\"" << type << "\" version=\"1.0\" byte_order=\""
+       << vtk_byte_order() << "\" header_type=\"UInt64\">" << std::endl;
+  }
+
+  /*!
+    write the size header of a raw appended data block
+  */
+  inline
+  void vtk_block_size(std::ostream& os, const std::uint64_t bytes)
+  {
+    os.write(reinterpret_cast<const char*>(&bytes), sizeof(bytes));
+  }
+
+  /*!
+    write an extent "i0 i1 j0 j1 0 0" of a 2D dataset
+  */
+  inline
+  void vtk_extent(std::ostream& os,
+                  const size_t i0, const size_t i1,
+                  const size_t j0, const size_t j1)
+  {
+    os << i0 << " " << i1 << " " << j0 << " " << j1 << " 0 0";
+  }
+
+  /*!
+    write an extent "i0 i1 j0 j1 k0 k1" of a 3D dataset
+  */
+  inline
+  void vtk_extent(std::ostream& os,
+                  const size_t i0, const size_t i1,
+                  const size_t j0, const size_t j1,
+                  const size_t k0, const size_t k1)
+  {
+    os << i0 << " " << i1 << " " << j0 << " " << j1 << " " << k0 << " " << k1;
+  }
+}
+
+#endif
@@ -0,0 +1,170 @@
+// implementation for cascade.h
+
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <utils/array2d.h>
+#include <utils/array_view.h>
+#include <algebra/blas.h>
+
+namespace AMSTeL
+{
+  template <class C>
+  Cascade<C>::Cascade(const InfiniteVector<C,int>& mask)
+    : mask_(), begin_(0), levels_()
+  {
+    assert(!mask.empty());
+
+    begin_ = mask.begin().index();
+    int last(begin_);
+    for (typename InfiniteVector<C,int>::const_iterator it(mask.begin()), itend(mask.end());
+	 it != itend; ++it)
+      last = it.index();
+    mask_.resize(last-begin_+1);
+    for (typename InfiniteVector<C,int>::const_iterator it(mask.begin()), itend(mask.end());
+	 it != itend; ++it)
+      mask_[it.index()-begin_] = it.value();
+
+    integer_values();
+  }
+
+  template <class C>
+  template <unsigned int N>
+  Cascade<C>::Cascade(const FixedArray1D<C,N>& mask, const int begin)
+    : mask_(N), begin_(begin), levels_()
+  {
+    for (unsigned int k(0); k < N; k++)
+      mask_[k] = mask[k];
+
+    integer_values();
+  }
+
+  template <class C>
+  void
+  Cascade<C>::integer_values()
+  {
+    const int length(mask_.size()-1); // k_1-k_0
+    Array1D<C> phi(length+1);
+
+    if (length <= 1)
+      phi[0] = C(1);
+    else
+      {
+	// solve (A-I)v = 0 for the interior integers k_0 < m < k_1, where A_{m,n} = a_{2m-n},
+	// replacing the last equation by the normalization sum_m v_m = 1
+	const int n(length-1);
+	Array2D<C> A(n, n+1);
+	for (int m(0); m < n; m++)
+	  {
+	    for (int l(0); l < n; l++)
+	      {
+		// global indices k_0+1+m, k_0+1+l, mask index 2(k_0+1+m)-(k_0+1+l)-k_0
+		const int k(2*m-l+1);
+		A(m,l) = (k >= 0 && k <= length ? mask_[k] : C(0)) - (m == l ? C(1) : C(0));
+	      }
+	    A(m,n) = C(0);
+	  }
+	for (int l(0); l <= n; l++)
+	  A(n-1,l) = C(1);
+
+	// Gaussian elimination with partial pivoting
+	for (int l(0); l < n; l++)
+	  {
+	    int p(l);
+	    for (int m(l+1); m < n; m++)
+	      if (std::abs(A(m,l)) > std::abs(A(p,l)))
+		p = m;
+	    for (int k(l); k <= n; k++)
+	      std::swap(A(l,k), A(p,k));
+	    for (int m(l+1); m < n; m++)
+	      {
+		const C factor(A(m,l)/A(l,l));
+		for (int k(l); k <= n; k++)
+		  A(m,k) -= factor*A(l,k);
+	      }
+	  }
+	for (int m(n-1); m >= 0; m--)
+	  {
+	    C v(A(m,n));
+	    for (int l(m+1); l < n; l++)
+	      v -= A(m,l)*phi[l+1];
+	    phi[m+1] = v/A(m,m);
+	  }
+      }
+
+    levels_.resize(1);
+    levels_[0].swap(phi);
+  }
+
+  template <class C>
+  const Array1D<C>&
+  Cascade<C>::values(const unsigned int resolution)
+  {
+    const int length(mask_.size()-1);
+    while (levels_.size() <= resolution)
+      {
+	// phi(k_0+i*2^{-(j+1)}) = sum_k a_k phi(k_0+(i-k*2^j)*2^{-j}), with k relative to k_0,
+	// i.e., v_{j+1}[i] = sum_k a_k v_j[i-k*2^j]
+	const unsigned int j(levels_.size()-1);
+	const size_t shift(size_t(1)<<j);
+	const size_t size(length*2*shift+1);
+	Array1D<C> next(size);
+	const Array1D<C>& current(levels_[j]);
+	for (int k(0); k <= length; k++)
+	  {
+	    // the source range [i-k*2^j] must lie within [0,length*2^j]
+	    const size_t first(k*shift), last(std::min(size-1, (length+k)*shift));
+	    if (mask_[k] != C(0) && first <= last)
+	      {
+		Array1DView<const C> x(current.begin()+first-k*shift, last-first+1);
+		Array1DView<C> y(next.begin()+first, last-first+1);
+		axpy(mask_[k], x, y);
+	      }
+	  }
+	levels_.push_back(std::move(next));
+      }
+    return levels_[resolution];
+  }
+
+  template <class C>
+  SampledMapping<1,C>
+  Cascade<C>::evaluate(const unsigned int resolution)
+  {
+    return SampledMapping<1,C>(Grid<1>(support_begin(), support_end(),
+				       (mask_.size()-1)<<resolution),
+			       values(resolution));
+  }
+
+  template <class C>
+  SampledMapping<1,C>
+  Cascade<C>::evaluate(const InfiniteVector<C,int>& coeffs, const unsigned int j,
+		       const int a, const int b, const unsigned int resolution)
+  {
+    assert(resolution >= j && b > a);
+
+    // phi_{j,k}(x_i) = 2^{j/2} phi((i+a*2^{resolution}-k*2^{resolution-j})*2^{-(resolution-j)}),
+    // so that each coefficient adds a shifted copy of the values on level resolution-j
+    const Array1D<C>& phi(values(resolution-j));
+    const long long step(1LL<<(resolution-j));
+    const long long points(((long long)(b-a)<<resolution)+1);
+    const C factor(std::pow(C(2), C(j)/2));
+
+    Array1D<C> f(points, first_touch);
+    for (typename InfiniteVector<C,int>::const_iterator it(coeffs.begin()), itend(coeffs.end());
+	 it != itend; ++it)
+      {
+	// index of the point (k_0+k)*2^{-j} and the overlap of supp phi_{j,k} with [a,b]
+	const long long offset((((long long)(support_begin()+it.index()))*step) - ((long long)a<<resolution));
+	const long long first(std::max(0LL, offset));
+	const long long last(std::min(points-1, offset+(long long)phi.size()-1));
+	if (first <= last)
+	  {
+	    Array1DView<const C> x(phi.begin()+(first-offset), last-first+1);
+	    Array1DView<C> y(f.begin()+first, last-first+1);
+	    axpy(factor*it.value(), x, y);
+	  }
+      }
+
+    return SampledMapping<1,C>(Grid<1>(a, b, (b-a)<<resolution), f);
+  }
+}
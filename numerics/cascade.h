@@ -0,0 +1,102 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_CASCADE_H
+#define _AMSTEL_CASCADE_H
+
+#include <utils/array1d.h>
+#include <utils/fixed_array1d.h>
+#include <algebra/infinite_vector.h>
+#include <geometry/sampled_mapping.h>
+
+namespace AMSTeL
+{
+  /*!
+    Point evaluation of a refinable function
+      phi(x) = sum_k a_k phi(2x-k),
+    with a finite refinement mask (a_k)_{k=k_0,...,k_1} normalized to sum_k a_k = 2,
+    by the cascade (subdivision) algorithm.
+
+    The values of phi at the integers are the normalized eigenvector of the
+    matrix (a_{2m-n})_{m,n} for the eigenvalue 1, and the values on the finer
+    grids 2^{-j}Z are obtained level by level via the refinement equation.
+    Each level is stored as a contiguous array of the values on supp phi = [k_0,k_1],
+    and each refinement step is a sequence of axpy() operations on shifted
+    contiguous ranges, i.e., a convolution with the mask which vectorizes well.
+    The levels are computed on demand and kept for later evaluations.
+
+    The refinable function is assumed to be continuous (phi(k_0) = phi(k_1) = 0);
+    for masks of length 2 (the box function), phi(k_0) = 1.
+  */
+  template <class C = double>
+  class Cascade
+  {
+  public:
+    /*!
+      constructor from a finite mask
+    */
+    Cascade(const InfiniteVector<C,int>& mask);
+
+    /*!
+      constructor from a mask with the entries a_{begin},...,a_{begin+N-1}
+    */
+    template <unsigned int N>
+    Cascade(const FixedArray1D<C,N>& mask, const int begin);
+
+    /*!
+      support [k_0,k_1] of the refinable function
+    */
+    inline int support_begin() const { return begin_; }
+    inline int support_end() const { return begin_+int(mask_.size())-1; }
+
+    /*!
+      the values phi(k_0+i*2^{-resolution}), i=0,...,(k_1-k_0)*2^{resolution}
+    */
+    const Array1D<C>& values(const unsigned int resolution);
+
+    /*!
+      phi, sampled on its support at the points 2^{-resolution}Z
+    */
+    SampledMapping<1,C> evaluate(const unsigned int resolution);
+
+    /*!
+      the linear combination sum_k c_k phi_{j,k}, phi_{j,k}(x) = 2^{j/2}phi(2^j x-k),
+      sampled on [a,b] at the points 2^{-resolution}Z (resolution >= j)
+    */
+    SampledMapping<1,C> evaluate(const InfiniteVector<C,int>& coeffs, const unsigned int j,
+				 const int a, const int b, const unsigned int resolution);
+
+  protected:
+    /*!
+      compute the values at the integers
+    */
+    void integer_values();
+
+    /*!
+      refinement mask a_{k_0},...,a_{k_1}
+    */
+    Array1D<C> mask_;
+
+    /*!
+      k_0
+    */
+    int begin_;
+
+    /*!
+      the values on the levels computed so far
+    */
+    Array1D<Array1D<C> > levels_;
+  };
+}
+
+#include <numerics/cascade.cpp>
+
+#endif
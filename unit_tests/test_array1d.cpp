@@ -1,6 +1,12 @@
 #include <iostream>
 #include <utils/array1d.h>
+#include <utils/parallel_for.h>
 #include <complex.h>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <filesystem>
 
 using std::cout;
 using std::endl;
@@ -32,6 +38,30 @@ int main()
   a=b;
   cout << "- a=b: "  << a << endl;
 
+  Array1D<double> f;
+  for (int i(0); i < 10; i++)
+    f.push_back(i*0.5);
+  cout << "- 10 times push_back(): " << f << endl;
+  cout << "  (size " << f.size() << ", capacity " << f.capacity() << ")" << endl;
+  f.emplace_back(f[0]);
+  f.resize(13);
+  cout << "- emplace_back() and resize(13) preserve the entries: " << f << endl;
+  f.resize(4);
+  f.shrink_to_fit();
+  cout << "- resize(4) and shrink_to_fit(): " << f << endl;
+  cout << "  (size " << f.size() << ", capacity " << f.capacity() << ")" << endl;
+  f.reserve(100);
+  cout << "- reserve(100): capacity " << f.capacity() << ", entries " << f << endl;
+  Array1D<double> h(std::move(f));
+  cout << "- move constructor h(std::move(f)): " << h << ", f has size " << f.size() << endl;
+  f = std::move(h);
+  cout << "- move assignment f=std::move(h): " << f << ", h has size " << h.size() << endl;
+  swap(f, h);
+  cout << "- swap(f,h): " << h << endl;
+
+  Array1D<double> g(3, no_initialization);
+  cout << "- an uninitialized Array1D<double>(3) has size " << g.size() << endl;
+
   typedef std::complex<double> C;
   Array1D<C> c(5);
   c[0]=C(3+2);
@@ -48,6 +78,76 @@ int main()
   
   c.resize(3);
   cout << "- c.resize(3): "  << c << endl;
+
+  cout << "- storage of a aligned to " << array_alignment<double>() << " bytes: "
+       << (reinterpret_cast<std::uintptr_t>(a.aligned_data()) % array_alignment<double>() == 0 ? "yes" : "no") << endl;
+
+  const std::string text("x = [1 2.5 -3e-2, 4];");
+  Array1D<double> e;
+  if (read_vector(text.data(), text.data()+text.size(), e))
+    cout << "- read_vector() from \"" << text << "\": " << e << endl;
+  const std::string malformed("[1 2 x]");
+  if (!read_vector(malformed.data(), malformed.data()+malformed.size(), e))
+    cout << "- read_vector() rejects malformed input" << endl;
+
+  set_number_of_threads(4);
+  Array1D<double> ft(100000, first_touch);
+  double sum(0);
+  for (unsigned int i(0); i < ft.size(); i++)
+    sum += ft[i];
+  cout << "- Array1D<double>(100000, first_touch) is zero: " << (sum == 0 ? "yes" : "no") << endl;
+  ft.resize(5, first_touch);
+  ft[4] = 1;
+  ft.resize(200000, first_touch);
+  sum = 0;
+  for (unsigned int i(0); i < ft.size(); i++)
+    sum += ft[i];
+  cout << "- ft.resize(5,first_touch), ft[4]=1, ft.resize(200000,first_touch), sum of entries: " << sum << endl;
+  try
+    {
+      parallel_for(0, 1000, [](const size_t, const size_t, const unsigned int chunk)
+		   {
+		     if (chunk == 2)
+		       throw std::runtime_error("chunk 2 failed");
+		   });
+      cout << "- an exception in a parallel_for() chunk was lost" << endl;
+    }
+  catch (const std::runtime_error& e)
+    {
+      cout << "- an exception in a parallel_for() chunk is rethrown: " << e.what() << endl;
+    }
+  set_number_of_threads(0);
+
+  Array1D<double> hp(1000, huge_pages);
+  hp.push_back(1);
+  cout << "- Array1D<double>(1000, huge_pages) stays on huge pages after push_back(): "
+       << (hp.storage() == storage_type::huge_pages ? "yes" : "no") << endl;
+
+  const std::string filename((std::filesystem::temp_directory_path() / "amstel_test_array1d.bin").string());
+  {
+    Array1D<double> out;
+    if (out.map_file(filename, file_access::read_write, 5))
+      {
+        for (unsigned int i(0); i < out.size(); i++)
+          out[i] = i*i;
+        cout << "- Array1D mapped onto a new file (read_write): " << out << endl;
+      }
+  }
+  Array1D<double> in;
+  if (in.map_file(filename, file_access::read_only))
+    {
+      cout << "- the file mapped read_only: " << in << endl;
+      in[0] = -1;
+    }
+  Array1D<double> in2;
+  if (in2.map_file(filename, file_access::read_only))
+    cout << "- the file is unchanged by writes to a read_only mapping: " << in2 << endl;
+  in2.push_back(25);
+  cout << "- push_back(25) detaches from the file: " << in2
+       << (in2.storage() == storage_type::aligned_heap ? " (on the heap)" : "") << endl;
+  std::filesystem::remove(filename);
+  if (!in2.map_file(filename, file_access::read_only))
+    cout << "- map_file() fails for a missing file" << endl;
   
   return 0;
 }
@@ -1,5 +1,12 @@
 #include <iostream>
+#include <algorithm>
+#include <sstream>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
 #include <utils/array2d.h>
+#include <utils/parallel_for.h>
 
 using std::cout;
 using std::endl;
@@ -41,4 +48,137 @@ int main()
   cout << " number of columns: " << a.column_dimension() << endl;
   cout << "- a.resize(1,3): "<< endl << a << endl;
 
+  Array2D<double> d(10,3);
+  cout << "- an Array2D<double>(10,3) d:" << endl;
+  cout << " leading dimension: " << d.leading_dimension() << endl;
+  cout << " storage size: " << d.storage_size() << endl;
+  cout << " columns aligned to " << array_alignment<double>() << " bytes: "
+       << (reinterpret_cast<std::uintptr_t>(&d(0,1)) % array_alignment<double>() == 0 ? "yes" : "no") << endl;
+
+  Array2D<double> e(std::move(d));
+  cout << "- move constructor e(std::move(d)): " << e.row_dimension() << "x" << e.column_dimension()
+       << ", d is " << d.row_dimension() << "x" << d.column_dimension() << endl;
+  d = std::move(e);
+  cout << "- move assignment d=std::move(e): " << d.row_dimension() << "x" << d.column_dimension() << endl;
+
+  std::ostringstream os;
+  os << b;
+  const std::string output(os.str());
+  Array2D<double> c;
+  if (read_matrix(output.data(), output.data()+output.size(), c))
+    cout << "- read_matrix() from the output of b: " << endl << c << endl;
+  const std::string text("[1 2 3; 4 5]");
+  if (!read_matrix(text.data(), text.data()+text.size(), c))
+    cout << "- read_matrix() rejects rows of different lengths" << endl;
+
+  Array2D<double> f(4,5);
+  for (unsigned int row(0); row < f.row_dimension(); row++)
+    for (unsigned int col(0); col < f.column_dimension(); col++)
+      f(row,col) = 10*row+col;
+  cout << "- an Array2D<double>(4,5) f:" << endl << f << endl;
+  cout << "- f.row(1): " << f.row(1) << endl;
+  cout << "- f.column(2): " << f.column(2) << endl;
+  cout << "- f.block(1,1,2,3):" << endl << f.block(1,1,2,3) << endl;
+  Array2DView<double> fv(f);
+  cout << "- interior of f:" << endl << fv.interior() << endl;
+  cout << "- transposed view of f:" << endl << fv.transposed() << endl;
+  Array1DView<double> r(f.row(3));
+  for (unsigned int i(0); i < r.size(); i++)
+    r[i] = -1;
+  cout << "- f after writing -1 through the view f.row(3):" << endl << f << endl;
+  Array2D<double,RowMajor> g;
+  convert_layout(f, g);
+  cout << "- f converted to row-major storage, leading dimension "
+       << g.leading_dimension() << ":" << endl << g << endl;
+  cout << "- g.column(1): " << g.column(1) << endl;
+  Array2D<double,Tiled<2> > h;
+  convert_layout(g, h);
+  cout << "- f converted to 2x2 tiles, storage size " << h.storage_size() << ":" << endl << h << endl;
+  cout << "- internal storage of the tiled array: [";
+  for (const double* it(h.storage_begin()); it != h.storage_end(); ++it)
+    cout << " " << *it;
+  cout << " ]" << endl;
+  Array2D<double> ft;
+  transpose(f, ft);
+  cout << "- transpose(f):" << endl << ft << endl;
+  Array2D<double> large(100,70), large_t, large_tt;
+  for (unsigned int col(0); col < large.column_dimension(); col++)
+    for (unsigned int row(0); row < large.row_dimension(); row++)
+      large(row,col) = row+1000*col;
+  transpose(large, large_t);
+  transpose(large_t, large_tt);
+  bool equal(true);
+  for (unsigned int col(0); col < large.column_dimension(); col++)
+    for (unsigned int row(0); row < large.row_dimension(); row++)
+      equal = equal && large(row,col) == large_tt(row,col);
+  cout << "- transposing a 100x70 array twice reproduces it: " << (equal ? "yes" : "no") << endl;
+  set_number_of_threads(4);
+  Array2D<double> zero(1000, 300, first_touch);
+  bool is_zero(true);
+  for (const double* it(zero.storage_begin()); it != zero.storage_end(); ++it)
+    is_zero = is_zero && *it == 0;
+  cout << "- Array2D<double>(1000,300,first_touch) is zero, including the padding: "
+       << (is_zero ? "yes" : "no") << endl;
+  Array2D<double> uninitialized(1000, 300, no_initialization);
+  ColumnMajor::clear_padding(uninitialized.storage_begin(), 1000, 300, uninitialized.leading_dimension());
+  for (unsigned int col(0); col < 300; col++)
+    for (unsigned int row(0); row < 1000; row++)
+      uninitialized(row,col) = 0;
+  cout << "- Array2D<double>(1000,300,no_initialization) has the same storage: "
+       << (std::equal(zero.storage_begin(), zero.storage_end(), uninitialized.storage_begin(), uninitialized.storage_end()) ? "yes" : "no") << endl;
+  Array2D<double> positive(13, 5);
+  for (unsigned int col(0); col < 5; col++)
+    for (unsigned int row(0); row < 13; row++)
+      positive(row,col) = 1+row+13*col;
+  static_assert(std::random_access_iterator<Array2D<double>::const_iterator>);
+  cout << "- iterators of a padded 13x5 array (leading dimension " << positive.leading_dimension()
+       << "): end()-begin()=" << positive.end()-positive.begin()
+       << ", min. " << *std::min_element(positive.begin(), positive.end())
+       << ", max. " << *std::max_element(positive.begin(), positive.end())
+       << ", last " << *(positive.end()-1) << endl;
+  set_number_of_threads(0);
+  const std::string filename((std::filesystem::temp_directory_path() / "amstel_test_array2d.bin").string());
+  {
+    Array2D<double> out;
+    if (out.map_file(filename, 2, 3, file_access::read_write))
+      {
+        for (unsigned int col(0); col < 3; col++)
+          for (unsigned int row(0); row < 2; row++)
+            out(row,col) = 10*row+col;
+        cout << "- a 2x3 Array2D mapped onto a new file (read_write):" << endl << out << endl;
+      }
+  }
+  cout << "- file size: " << std::filesystem::file_size(filename) << " bytes" << endl;
+  Array2D<double,RowMajor> in;
+  if (in.map_file(filename, 3, 2, file_access::read_only))
+    cout << "- the file mapped read_only as a row-major 3x2 array (the transpose):" << endl << in << endl;
+  std::filesystem::remove(filename);
+
+  {
+    // mapped arrays are not padded, heap arrays are
+    Array2D<double> heap(10, 10), mapped;
+    for (unsigned int col(0); col < 10; col++)
+      for (unsigned int row(0); row < 10; row++)
+        heap(row,col) = -(10.0*row+col);
+    if (mapped.map_file(filename, 10, 10, file_access::read_write))
+      {
+        mapped = heap;
+        cout << "- assignment of a heap 10x10 array (ld " << heap.leading_dimension()
+             << ") into a mapped one (ld " << mapped.leading_dimension() << "): m(3,4)="
+             << mapped(3,4) << ", file size " << std::filesystem::file_size(filename) << " bytes" << endl;
+        Array2D<double> copy(mapped);
+        mapped(3,4) = 1.0;
+        heap = mapped;
+        cout << "- a copy of the mapped array has ld " << copy.leading_dimension()
+             << ", c(3,4)=" << copy(3,4) << ", c(9,9)=" << copy(9,9)
+             << ", assigned back to the heap array: h(3,4)=" << heap(3,4)
+             << ", h(9,9)=" << heap(9,9) << ", padding zero: " << (*(&heap(9,9)+1) == 0) << endl;
+      }
+  }
+  std::filesystem::remove(filename);
+
+  Array2D<double> hp(100, 100, huge_pages);
+  hp.resize(200, 50);
+  cout << "- Array2D<double>(100,100,huge_pages) stays on huge pages after resize(): "
+       << (hp.storage() == storage_type::huge_pages ? "yes" : "no") << endl;
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+#include <utils/array1d.h>
+#include <utils/array2d.h>
+#include <algebra/blas.h>
+
+using std::cout;
+using std::endl;
+using namespace AMSTeL;
+
+int main()
+{
+  cout << "Testing the BLAS-like kernels ..." << endl;
+
+  Array1D<double> x(4), y(4);
+  for (unsigned int i(0); i < x.size(); i++)
+    {
+      x[i] = i+1;
+      y[i] = 1;
+    }
+  cout << "- x=" << x << ", y=" << y << endl;
+  cout << "- dot(x,y)=" << dot(x, y) << endl;
+  cout << "- nrm2(x)=" << nrm2(x) << endl;
+  axpy(2.0, x, y);
+  cout << "- axpy(2,x,y): y=" << y << endl;
+
+  Array1D<double> big(2);
+  big[0] = 3e200;
+  big[1] = 4e200;
+  cout << "- nrm2() without overflow: " << nrm2(big) << endl;
+
+  Array2D<double> A(3,4);
+  for (unsigned int row(0); row < A.row_dimension(); row++)
+    for (unsigned int col(0); col < A.column_dimension(); col++)
+      A(row,col) = row+col;
+  cout << "- A=" << endl << A << endl;
+  Array1D<double> z(3);
+  gemv(1.0, A, x, 0.0, z);
+  cout << "- gemv(1,A,x,0,z): z=" << z << endl;
+  Array2DView<const double> At(Array2DView<const double>(A).transposed());
+  Array1D<double> w(4);
+  gemv(1.0, At, z, 0.0, w);
+  cout << "- gemv(1,A^T,z,0,w): w=" << w << endl;
+
+  Array2D<double> B(4,2), D(3,2);
+  for (unsigned int row(0); row < B.row_dimension(); row++)
+    for (unsigned int col(0); col < B.column_dimension(); col++)
+      B(row,col) = row == col ? 1 : 0.5;
+  gemm(1.0, A, B, 0.0, D);
+  cout << "- B=" << endl << B << endl;
+  cout << "- gemm(1,A,B,0,D): D=" << endl << D << endl;
+
+  // compare the blocked kernels with the generic loops (row-major storage)
+  const unsigned int m(101), n(67), k(259);
+  Array2D<double> A1(m,k), B1(k,n), D1(m,n), D2(m,n);
+  Array2D<double,RowMajor> A2, B2, D3(m,n);
+  for (unsigned int col(0); col < k; col++)
+    for (unsigned int row(0); row < m; row++)
+      A1(row,col) = std::sin(double(row+2*col));
+  for (unsigned int col(0); col < n; col++)
+    for (unsigned int row(0); row < k; row++)
+      B1(row,col) = std::cos(double(3*row+col));
+  for (unsigned int col(0); col < n; col++)
+    for (unsigned int row(0); row < m; row++)
+      D1(row,col) = D3(row,col) = double(row)-col;
+  convert_layout(A1, A2);
+  convert_layout(B1, B2);
+  gemm(0.5, A1, B1, 2.0, D1);
+  gemm(0.5, A2, B2, 2.0, D3);
+  double error(0);
+  for (unsigned int col(0); col < n; col++)
+    for (unsigned int row(0); row < m; row++)
+      error = std::max(error, std::fabs(D1(row,col)-D3(row,col)));
+  cout << "- blocked vs. generic gemm for a " << m << "x" << k << " times " << k << "x" << n
+       << " product, maximal deviation below 1e-12: " << (error < 1e-12 ? "yes" : "no") << endl;
+
+  Array1D<double> v(k), u1(m), u2(m);
+  for (unsigned int i(0); i < k; i++)
+    v[i] = 1.0/(i+1);
+  gemv(1.0, A1, v, 0.0, u1);
+  gemv(1.0, A2, v, 0.0, u2);
+  error = 0;
+  for (unsigned int i(0); i < m; i++)
+    error = std::max(error, std::fabs(u1[i]-u2[i]));
+  cout << "- blocked vs. generic gemv, maximal deviation below 1e-12: " << (error < 1e-12 ? "yes" : "no") << endl;
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <utils/fixed_array1d.h>
+#include <algebra/infinite_vector.h>
+#include <numerics/cascade.h>
+
+using std::cout;
+using std::endl;
+using namespace AMSTeL;
+
+int main()
+{
+  cout << "Testing the cascade algorithm..." << endl;
+
+  InfiniteVector<double,int> hat_mask;
+  hat_mask.set_coefficient(-1, 0.5);
+  hat_mask.set_coefficient(0, 1.0);
+  hat_mask.set_coefficient(1, 0.5);
+  Cascade<> hat(hat_mask);
+  cout << "- the hat function on [" << hat.support_begin() << "," << hat.support_end()
+       << "], sampled at 2^{-2}Z:" << endl;
+  hat.evaluate(2).matlab_output(cout);
+
+  InfiniteVector<double,int> coeffs;
+  for (int k(0); k <= 4; k++)
+    coeffs.set_coefficient(k, 1.0);
+  cout << "- sum_{k=0}^4 phi_{0,k} on [0,4] (partition of unity in the interior):" << endl;
+  hat.evaluate(coeffs, 0, 0, 4, 1).matlab_output(cout);
+
+  cout << "- phi_{1,1} on [0,2], sampled at 2^{-2}Z:" << endl;
+  InfiniteVector<double,int> single;
+  single.set_coefficient(1, 1.0);
+  hat.evaluate(single, 1, 0, 2, 2).matlab_output(cout);
+
+  const double s3(std::sqrt(3.0));
+  const FixedArray1D<double,4> d4_mask{(1+s3)/4, (3+s3)/4, (3-s3)/4, (1-s3)/4};
+  Cascade<> d4(d4_mask, 0);
+  const Array1D<double>& d4_integers(d4.values(0));
+  cout << "- Daubechies' D4 scaling function at the integers: " << d4_integers
+       << " (exact: [0 " << (1+s3)/2 << " " << (1-s3)/2 << " 0])" << endl;
+
+  const unsigned int resolution(20);
+  auto t0 = std::chrono::steady_clock::now();
+  const Array1D<double>& d4_fine(d4.values(resolution));
+  auto t1 = std::chrono::steady_clock::now();
+  double sum(0);
+  for (unsigned int i(0); i < d4_fine.size(); i++)
+    sum += d4_fine[i];
+  cout << "- D4 on 2^{-" << resolution << "}Z: " << d4_fine.size() << " values in "
+       << std::chrono::duration<double, std::milli>(t1-t0).count() << "ms, "
+       << "integral approx. " << sum/(1<<resolution) << endl;
+
+  return 0;
+}
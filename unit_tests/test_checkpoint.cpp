@@ -0,0 +1,65 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <algebra/infinite_vector.h>
+#include <io/checkpoint.h>
+
+using std::cout;
+using std::endl;
+using namespace AMSTeL;
+
+int main()
+{
+  cout << "Testing incremental checkpoints of InfiniteVector..." << endl;
+
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  InfiniteVectorCheckpointWriter<double,int> writer(stream, 3);
+
+  InfiniteVector<double,int> v, v2, v5;
+  for (int iteration(0); iteration < 7; iteration++)
+    {
+      v[iteration] = 1.0;
+      v[0] += 0.5;
+      if (iteration == 4)
+        v.add_coefficient(2, -1.0); // erase an entry
+      if (iteration == 2)
+        v2 = v;
+      if (iteration == 5)
+        v5 = v;
+      writer.write(v);
+      cout << "- checkpoint " << iteration << ", stream size: " << stream.str().size() << endl;
+    }
+
+  InfiniteVector<double,int> w;
+  cout << "- restore last checkpoint: "
+       << (restore_checkpoint(stream, w) && w == v ? "ok" : "failed") << endl;
+  cout << w;
+
+  stream.clear();
+  stream.seekg(0);
+  cout << "- restore checkpoint 2: "
+       << (restore_checkpoint(stream, w, 2) && w == v2 ? "ok" : "failed") << endl;
+
+  stream.clear();
+  stream.seekg(0);
+  cout << "- restore checkpoint 5 (from the base at checkpoint 3): "
+       << (restore_checkpoint(stream, w, 5) && w == v5 ? "ok" : "failed") << endl;
+
+  stream.clear();
+  stream.seekg(0);
+  cout << "- restore checkpoint 9 (does not exist): "
+       << (restore_checkpoint(stream, w, 9) ? "ok" : "failed") << endl;
+
+  std::stringstream truncated(stream.str().substr(0, stream.str().size()-5),
+                              std::ios::in | std::ios::binary);
+  cout << "- restore the last checkpoint from a truncated stream: "
+       << (restore_checkpoint(truncated, w) ? "ok" : "failed") << endl;
+
+  std::ofstream unwritable("/nonexistent/directory/checkpoints.bin", std::ios::binary);
+  InfiniteVectorCheckpointWriter<double,int> failing_writer(unwritable);
+  cout << "- checkpoint onto an unwritable stream: "
+       << (failing_writer.write(v) ? "ok" : "failed")
+       << " (" << failing_writer.checkpoints() << " checkpoints)" << endl;
+
+  return 0;
+}
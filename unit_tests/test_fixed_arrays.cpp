@@ -0,0 +1,67 @@
+#include <iostream>
+#include <string>
+#include <utils/fixed_array1d.h>
+#include <utils/fixed_array2d.h>
+#include <utils/array1d.h>
+#include <algebra/blas.h>
+
+using std::cout;
+using std::endl;
+using namespace AMSTeL;
+
+// constexpr evaluation of a generic routine on a fixed-size array
+template <class VECTOR>
+constexpr typename VECTOR::value_type sum(const VECTOR& v)
+{
+  typename VECTOR::value_type s(0);
+  for (unsigned int i(0); i < v.size(); i++)
+    s += v[i];
+  return s;
+}
+
+int main()
+{
+  cout << "Testing the FixedArray1D and FixedArray2D classes..." << endl;
+
+  constexpr FixedArray1D<double,3> mask{0.5, 1.0, 0.5};
+  static_assert(sum(mask) == 2.0);
+  cout << "- a constexpr FixedArray1D<double,3> mask: " << mask << endl;
+  cout << "  (size: " << mask.size() << ", sum evaluated at compile time: " << sum(mask) << ")" << endl;
+
+  FixedArray1D<int,4> a;
+  cout << "- a default FixedArray1D<int,4> a: " << a << endl;
+  a[1] = 2; a[3] = 42;
+  a.swap(0,3);
+  cout << "- a after writing and swapping entries: " << a << endl;
+
+  FixedArray1D<double,3> b{1, 2, 3};
+  Array1D<double> c(3);
+  c[0] = 1; c[1] = 1; c[2] = 1;
+  cout << "- generic dot() of FixedArray1D " << b << " and Array1D " << c << ": " << dot(b, c) << endl;
+
+  const std::string text("[4 5 6]"), wrong("[4 5]");
+  if (read_vector(text.data(), text.data()+text.size(), b))
+    cout << "- read_vector() into b: " << b << endl;
+  if (!read_vector(wrong.data(), wrong.data()+wrong.size(), b))
+    cout << "- read_vector() rejects a vector of the wrong length" << endl;
+
+  constexpr FixedArray2D<double,2,3> A{{1, 2, 3}, {4, 5, 6}};
+  static_assert(A(1,0) == 4.0 && A.row_dimension() == 2 && A.column_dimension() == 3);
+  cout << "- a constexpr FixedArray2D<double,2,3> A:" << endl << A << endl;
+  cout << "- A.row(1): " << A.row(1) << ", A.column(2): " << A.column(2) << endl;
+  cout << "- internal storage of A: [";
+  for (FixedArray2D<double,2,3>::const_iterator it(A.begin()); it != A.end(); ++it)
+    cout << " " << *it;
+  cout << " ]" << endl;
+
+  FixedArray1D<double,2> y;
+  gemv(1.0, A, b, 0.0, y);
+  cout << "- generic gemv() A*b: " << y << endl;
+
+  FixedArray2D<double,3,2> B{{1, 0}, {0, 1}, {1, 1}};
+  FixedArray2D<double,2,2> D;
+  gemm(1.0, A, B, 0.0, D);
+  cout << "- generic gemm() A*B:" << endl << D << endl;
+
+  return 0;
+}
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <algorithm>
 #include <utils/array1d.h>
 #include <utils/array2d.h>
 #include <geometry/grid.h>
@@ -24,6 +25,27 @@ int main()
   cout << "- an equidistant 1D grid:" << endl;
   Grid<1>(0.0, 1.0, 5).matlab_output(cout);
 
+  Grid<1> equi1d(0.0, 1.0, 1000000);
+  cout << "- an equidistant 1D grid with " << equi1d.size() << " points (stored: "
+       << equi1d.is_equidistant() << "), x_250000=" << equi1d.point(250000)
+       << ", 0.3 lies in cell " << equi1d.locate(0.3)
+       << ", 1.5 in cell " << equi1d.locate(1.5) << endl;
+  cout << "- in the non-equidistant grid [1 2.4 3], 2.5 lies in cell " << Grid<1>(points).locate(2.5)
+       << ", 0 in cell " << Grid<1>(points).locate(0.0) << endl;
+
+  Array1D<double> squares(1000);
+  for (unsigned int i(0); i < squares.size(); i++)
+    squares[i] = double(i)*i;
+  Grid<1> nonuniform(squares);
+  unsigned int mismatches(0);
+  for (double x(-10.0); x < 1.01e6; x += 37.5)
+    {
+      const unsigned int k(std::upper_bound(squares.begin(), squares.end(), x) - squares.begin());
+      mismatches += nonuniform.locate(x) != (k == 0 ? 0 : std::min(k-1, 998u));
+    }
+  cout << "- locate() on a non-uniform grid with 1000 points agrees with std::upper_bound: "
+       << (mismatches == 0) << endl;
+
   cout << "- empty 2D grid:" << endl;
   Grid<2>().matlab_output(cout);
 
@@ -45,6 +67,16 @@ int main()
   Grid<2> tensor(gx, gy);
   tensor.matlab_output(cout);
 
+  cout << "- tensor product grids only store their axes: "
+       << Grid<2>(gridx, gridy).is_tensor_product() << tensor.is_tensor_product()
+       << " (x(1,2)=" << tensor.x(1,2) << ", y(1,2)=" << tensor.y(1,2) << ")" << endl;
+
+  cout << "- a curvilinear 2D grid:" << endl;
+  gridx(1,1) = 1.5;
+  Grid<2> curved(gridx, gridy);
+  curved.matlab_output(cout);
+  cout << "  (tensor product: " << curved.is_tensor_product() << ")" << endl;
+
   cout << "- test assignment operator:" << endl;
   equi = tensor;
   equi.matlab_output(cout);
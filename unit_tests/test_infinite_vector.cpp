@@ -63,6 +63,19 @@ int main()
   s /= 3;
   cout << s;
   
+  cout << "- delta of s relative to a marker:" << endl;
+  InfiniteVector<float,long int> marker(s), changed;
+  std::set<long int> erased;
+  s[3] = 1;
+  s[7] = 5;
+  s.add_coefficient(1, -s[1]);
+  s.delta(marker, changed, erased);
+  cout << "  changed entries:" << endl << changed;
+  cout << "  number of erased entries: " << erased.size() << endl;
+  marker.apply_delta(changed, erased);
+  cout << "  replaying the delta on the marker yields s again? "
+       << (marker == s ? "yes" : "no") << endl;
+
   // now testing different CONTAINER arguments
   InfiniteVector<double,long int,std::unordered_map<long int,double> > z;
   cout << "- a zero vector with hashed container:" << endl
@@ -1,7 +1,16 @@
 #include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <iterator>
+#include <chrono>
 #include<cmath>
+#include <type_traits>
+#include <span>
+#include <stdexcept>
 #include <geometry/grid.h>
 #include <geometry/sampled_mapping.h>
+#include <geometry/sampled_mapping_norms.h>
 #include <algebra/infinite_vector.h>
 
 
@@ -38,9 +47,28 @@ int main()
    cout << "- testing SampledMapping<1> constructed by infinitevector:" << endl;
   si.matlab_output(cout);   
 
+  cout << "- testing SampledMapping<2> constructed by a tensor-indexed infinitevector:" << endl;
+  InfiniteVector<double, std::pair<int,int> > st;
+  st.set_coefficient(std::make_pair(-1, 0), 7.0); // outside
+  st.set_coefficient(std::make_pair(0, -3), 8.0); // outside
+  st.set_coefficient(std::make_pair(0, 1), 1.0);
+  st.set_coefficient(std::make_pair(1, 2), 2.0);
+  st.set_coefficient(std::make_pair(1, 5), 9.0); // outside
+  st.set_coefficient(std::make_pair(2, 0), 3.0);
+  st.set_coefficient(std::make_pair(3, 0), 4.0); // outside
+  SampledMapping<2, double> st_mapping(0, 0, 1, 1, st, 1);
+  st_mapping.matlab_output(cout);
 
 
 
+
+  cout << "- SampledMapping<1> is nothrow move constructible: "
+       << (std::is_nothrow_move_constructible_v<SampledMapping<1> > ? "yes" : "no") << endl;
+  Array1D<SampledMapping<1> > mappings;
+  for (int i(0); i < 3; i++)
+    mappings.push_back(SampledMapping<1>(Grid<1>(0.0, 1.0, 2)));
+  cout << "- an Array1D of " << mappings.size() << " sampled mappings, built with push_back()" << endl;
+
   cout << "- Matlab output of a sampled function on a 2D grid:" << endl;
   //Grid<2> grid(Point<2>(0.0, 0.0), Point<2>(1.0, 1.0), 4, 4);
   Grid<2> grid(0.0, 0.0, 1.0, 1.0, 4, 4);
@@ -56,5 +84,272 @@ int main()
   h.octave_output(cout);
   //h.matlab_output(cout);
 
+  cout << "- fused pointwise operations on 2D mappings:" << endl;
+  SampledMapping<2,double> h2(grid, b), h3(grid, b);
+  h2.axpby(3.0, h3, 0.5);      // 3*1 + 0.5*1
+  h2.add(1.0, h3, -2.0, h3);   // -1
+  h2.multiply(h);              // *2
+  h2.apply([](const double x) { return x*x; });
+  h2.apply([](const double x, const double y) { return x-y; }, h);
+  cout << "  ((3+0.5-1)*2)^2-2 = " << h2.values()(2,3) << endl;
+
+  {
+    const unsigned int N(2048);
+    SampledMapping<2,double> u(Grid<2>(0.0, 0.0, 1.0, 1.0, N)), v(u), w(u);
+    v.apply([](const double) { return 1.0; });
+    auto t0 = std::chrono::steady_clock::now();
+    u.add(2.0, v, 3.0, w);
+    auto t1 = std::chrono::steady_clock::now();
+    cout << "- fused update u += 2v+3w on a " << N+1 << "^2 grid: "
+	 << std::chrono::duration<double, std::milli>(t1-t0).count() << "ms, u(7,7)=" << u.values()(7,7) << endl;
+  }
+
+  cout << "- VTK output of a sampled function on an equidistant 2D grid:" << endl;
+  const std::string base((std::filesystem::temp_directory_path() / "amstel_sampled_mapping").string());
+  std::string filename(h.vtk_output(base));
+  cout << "  " << std::filesystem::path(filename).filename().string()
+       << ", " << std::filesystem::file_size(filename) << " bytes" << endl;
+  std::filesystem::remove(filename);
+
+  cout << "- parallel VTK output in 2x2 pieces:" << endl;
+  filename = h.vtk_output(base, 2, 2);
+  std::ifstream ifs(filename.c_str());
+  cout << ifs.rdbuf();
+  ifs.close();
+  std::filesystem::remove(filename);
+  for (int piece(0); piece < 4; piece++)
+    std::filesystem::remove(base + "_" + std::to_string(piece) + ".vti");
+
+  cout << "- VTK output into a nonexistent directory: \""
+       << h.vtk_output("/nonexistent/directory/sampled_mapping") << "\", \""
+       << h.vtk_output("/nonexistent/directory/sampled_mapping", 2, 2) << "\"" << endl;
+
+  cout << "- VTK output of a sampled function on a non-equidistant 2D grid:" << endl;
+  Array1D<double> points(3);
+  points[0] = 0.0; points[1] = 0.2; points[2] = 1.0;
+  SampledMapping<2,double> k(Grid<2>(Grid<1>(points), Grid<1>(0.0, 1.0, 2)), Array2D<double>(3,3));
+  filename = k.vtk_output(base);
+  cout << "  " << std::filesystem::path(filename).filename().string()
+       << ", " << std::filesystem::file_size(filename) << " bytes" << endl;
+  std::filesystem::remove(filename);
+
+  cout << "- a sampled function on a 3D grid:" << endl;
+  Grid<3> cube(0.0, 1.0, 2);
+  Array1D<double> v(cube.size());
+  for (unsigned int k(0), i(0); k < cube.dimension(2); k++)
+    for (unsigned int m(0); m < cube.dimension(1); m++)
+      for (unsigned int n(0); n < cube.dimension(0); n++, i++)
+	v[i] = cube.axis(0).point(n) + 2*cube.axis(1).point(m) + 3*cube.axis(2).point(k);
+  SampledMapping<3> volume(cube, v);
+  volume.matlab_output(cout, true);
+  cout << "- its slice z=0.5:" << endl;
+  volume.slice(1).matlab_output(cout);
+
+  cout << "- VTK output of the 3D function, directly and slice by slice:" << endl;
+  filename = base + ".vti";
+  std::ofstream vti(filename.c_str(), std::ios::out | std::ios::binary);
+  volume.vtk_output(vti);
+  vti.close();
+  const std::string sliced_filename(base + "_sliced.vti");
+  std::ofstream sliced(sliced_filename.c_str(), std::ios::out | std::ios::binary);
+  vtk_slice_output<double>(sliced, cube,
+			   [&](const unsigned int k, Array2D<double>& plane)
+			   {
+			     // only the current slice is computed
+			     for (unsigned int n(0); n < plane.column_dimension(); n++)
+			       for (unsigned int m(0); m < plane.row_dimension(); m++)
+				 plane(m,n) = cube.axis(0).point(n) + 2*cube.axis(1).point(m) + 3*cube.axis(2).point(k);
+			   });
+  sliced.close();
+  std::ifstream direct_ifs(filename.c_str(), std::ios::binary), sliced_ifs(sliced_filename.c_str(), std::ios::binary);
+  const std::string direct_contents((std::istreambuf_iterator<char>(direct_ifs)), std::istreambuf_iterator<char>());
+  const std::string sliced_contents((std::istreambuf_iterator<char>(sliced_ifs)), std::istreambuf_iterator<char>());
+  cout << "  " << direct_contents.size() << " bytes, identical: " << (direct_contents == sliced_contents) << endl;
+  std::filesystem::remove(filename);
+  std::filesystem::remove(sliced_filename);
+
+  cout << "- VTK output of a 3D function on a non-equidistant grid:" << endl;
+  SampledMapping<3> curved_volume(Grid<3>({Grid<1>(points), Grid<1>(0.0, 1.0, 3), Grid<1>(points)}));
+  std::ostringstream vtr;
+  curved_volume.vtk_output(vtr);
+  cout << vtr.str().substr(0, vtr.str().find("<AppendedData"));
+
+  cout << "- many sampled mappings over one curvilinear 2D grid:" << endl;
+  Array2D<double> curved_x(64, 64), curved_y(64, 64);
+  for (unsigned int n(0); n < 64; n++)
+    for (unsigned int m(0); m < 64; m++)
+      {
+	curved_x(m,n) = n/63.0 + 0.1*m/63.0;
+	curved_y(m,n) = m/63.0;
+      }
+  const Grid<2> curved_grid(curved_x, curved_y);
+  Array1D<SampledMapping<2> > snapshots(100);
+  for (unsigned int i(0); i < snapshots.size(); i++)
+    {
+      snapshots[i] = SampledMapping<2>(curved_grid);
+      snapshots[i].add(double(i), snapshots[0]);
+    }
+  unsigned int shared(0);
+  for (unsigned int i(0); i < snapshots.size(); i++)
+    shared += snapshots[i].shares_grid(curved_grid);
+  cout << "  " << shared << " of " << snapshots.size() << " mappings share the grid points, "
+       << "a separately built copy is the same grid: " << curved_grid.same_grid(Grid<2>(curved_x, curved_y))
+       << ", but does not share it: " << curved_grid.shares_grid(Grid<2>(curved_x, curved_y)) << endl;
+
+  cout << "- interpolation of p(x)=x^3-x on an equidistant and a non-uniform 1D grid:" << endl;
+  Array1D<double> nodes(33), cubic_values(33), equi_values(33);
+  for (unsigned int i(0); i < nodes.size(); i++)
+    {
+      nodes[i] = std::pow(i/32.0, 2);
+      cubic_values[i] = nodes[i]*nodes[i]*nodes[i]-nodes[i];
+      equi_values[i] = std::pow(i/32.0, 3)-i/32.0;
+    }
+  const SampledMapping<1> p_equi(Grid<1>(0.0, 1.0, 32), equi_values), p_nonuniform(Grid<1>(nodes), cubic_values);
+  Array1D<double> queries(1000000), interpolated;
+  for (unsigned int i(0); i < queries.size(); i++)
+    queries[i] = std::fmod(0.618034*i, 1.0);
+  for (interpolation method : {interpolation::linear, interpolation::cubic})
+    for (const SampledMapping<1>* p : {&p_equi, &p_nonuniform})
+      {
+	auto t0 = std::chrono::steady_clock::now();
+	p->evaluate(queries, interpolated, method);
+	auto t1 = std::chrono::steady_clock::now();
+	double error(0);
+	for (unsigned int i(0); i < queries.size(); i++)
+	  error = std::max(error, std::fabs(interpolated[i] - (std::pow(queries[i], 3)-queries[i])));
+	cout << "  " << (method == interpolation::linear ? "linear" : "cubic")
+	     << (p->is_equidistant() ? ", equidistant" : ", non-uniform")
+	     << ": max. error " << (error < 1e-12 ? 0.0 : error) << " at " << queries.size() << " points in "
+	     << std::chrono::duration<double, std::milli>(t1-t0).count() << "ms" << endl;
+      }
+
+  cout << "- bicubic interpolation of q(x,y)=x^2*y on a 2D tensor product grid:" << endl;
+  Array2D<double> q_values(9, 33);
+  for (unsigned int n(0); n < 33; n++)
+    for (unsigned int m(0); m < 9; m++)
+      q_values(m,n) = nodes[n]*nodes[n]*m/8.0;
+  const SampledMapping<2> q(Grid<2>(Grid<1>(nodes), Grid<1>(0.0, 1.0, 8)), q_values);
+  Array1D<double> queries_y(queries.size());
+  for (unsigned int i(0); i < queries.size(); i++)
+    queries_y[i] = std::fmod(0.414214*i, 1.0);
+  q.evaluate(queries, queries_y, interpolated, interpolation::cubic);
+  double q_error(0);
+  for (unsigned int i(0); i < queries.size(); i++)
+    q_error = std::max(q_error, std::fabs(interpolated[i] - queries[i]*queries[i]*queries_y[i]));
+  cout << "  max. error " << (q_error < 1e-12 ? 0.0 : q_error)
+       << ", q(0.5,0.5)=" << q.evaluate(0.5, 0.5) << " (bilinear)" << endl;
+  try
+    {
+      snapshots[0].evaluate(0.5, 0.5);
+      cout << "  evaluation on a curvilinear grid was not rejected" << endl;
+    }
+  catch (const std::invalid_argument&)
+    {
+      cout << "  evaluation on a curvilinear grid is rejected" << endl;
+    }
+
+  cout << "- discrete norms of sin(pi*x) on [0,1] (exact: L_2 0.707107, H^1 2.22144):" << endl;
+  const double pi(M_PI);
+  for (unsigned int N : {16u, 64u, 256u})
+    {
+      Array1D<double> sine(N+1);
+      for (unsigned int i(0); i <= N; i++)
+	sine[i] = std::sin(pi*i/N);
+      const SampledMapping<1> u(Grid<1>(0.0, 1.0, N), sine);
+      const DiscreteNorms trapezoidal(discrete_norms(u)), simpson(discrete_norms(u, quadrature_rule::simpson));
+      cout << "  N=" << N << ": L_2 (trapezoidal) " << trapezoidal.l2
+	   << ", L_2 (Simpson) " << simpson.l2
+	   << ", L_infty " << trapezoidal.linfty << ", H^1 " << trapezoidal.h1 << endl;
+    }
+
+  cout << "- discrete distances in 2D, sin(pi*x)*sin(pi*y) vs. 1.001 times it (exact: L_2 0.0005, H^1 0.00222144):" << endl;
+  const Grid<2> square(0.0, 0.0, 1.0, 1.0, 512, 512);
+  Array2D<double> product(513, 513);
+  for (unsigned int n(0); n <= 512; n++)
+    for (unsigned int m(0); m <= 512; m++)
+      product(m,n) = std::sin(pi*n/512)*std::sin(pi*m/512);
+  const SampledMapping<2> w(square, product);
+  SampledMapping<2> w_scaled(w);
+  w_scaled.mult(1.001);
+  auto t2 = std::chrono::steady_clock::now();
+  const DiscreteNorms distances(discrete_distances(w, w_scaled, quadrature_rule::simpson));
+  auto t3 = std::chrono::steady_clock::now();
+  cout << "  L_2 " << distances.l2 << ", L_infty " << distances.linfty << ", H^1 " << distances.h1
+       << " (norm of w: L_2 " << l2_norm(w) << ", H^1 " << h1_seminorm(w) << "), "
+       << std::chrono::duration<double, std::milli>(t3-t2).count() << "ms" << endl;
+
+  cout << "- decimation of sin(2*pi*x) on 2^16+1 points with spikes +5 and -3 to 200 points:" << endl;
+  const unsigned int fine(1<<16);
+  Array1D<double> spiky(fine+1);
+  for (unsigned int i(0); i <= fine; i++)
+    spiky[i] = std::sin(2*pi*i/fine);
+  spiky[12345] = 5.0;
+  spiky[54321] = -3.0;
+  const SampledMapping<1> fine_mapping(Grid<1>(0.0, 1.0, fine), spiky);
+  const SampledMapping<1> coarse_mapping(fine_mapping.decimate(200));
+  std::ostringstream fine_output, coarse_output;
+  fine_mapping.matlab_output(fine_output);
+  coarse_mapping.matlab_output(coarse_output);
+  cout << "  " << coarse_mapping.size() << " points, max. " << linfty_norm(coarse_mapping)
+       << " at x=" << coarse_mapping.point(std::max_element(coarse_mapping.values().begin(), coarse_mapping.values().end())
+					  - coarse_mapping.values().begin())
+       << ", min. " << *std::min_element(coarse_mapping.values().begin(), coarse_mapping.values().end())
+       << ", Matlab output " << fine_output.str().size() << " -> " << coarse_output.str().size() << " bytes" << endl;
+  for (unsigned int budget : {0u, 1u, 2u, 3u, 7u, 200u})
+    {
+      const SampledMapping<1> decimated(fine_mapping.decimate(budget));
+      const bool endpoints(decimated.size() < 2
+			   || (decimated.point(0) == fine_mapping.point(0)
+			       && decimated.point(decimated.size()-1) == fine_mapping.point(fine)
+			       && decimated.values()[decimated.size()-1] == spiky[fine]));
+      cout << "  budget " << budget << ": " << decimated.size() << " points"
+	   << (decimated.size() <= budget ? "" : " (over budget!)")
+	   << (endpoints ? "" : " (endpoints lost!)") << endl;
+    }
+
+  cout << "- decimation of the 2D function above with a spike to 32x16 bins:" << endl;
+  product(100, 200) = 7.0;
+  const SampledMapping<2> spiky_2d(square, product);
+  const SampledMapping<2> coarse_2d(spiky_2d.decimate(32, 16));
+  cout << "  " << coarse_2d.column_dimension() << "x" << coarse_2d.row_dimension()
+       << " points, max. " << linfty_norm(coarse_2d)
+       << ", domain [" << coarse_2d.axis_x().point(0) << "," << coarse_2d.axis_x().point(31)
+       << "]x[" << coarse_2d.axis_y().point(0) << "," << coarse_2d.axis_y().point(15) << "]" << endl;
+
+  cout << "- sampling functions in parallel:" << endl;
+  const SampledMapping<1> sampled_sine(Grid<1>(0.0, 1.0, fine), [&](const double x) { return std::sin(2*pi*x); });
+  const SampledMapping<1> batched_sine(Grid<1>(0.0, 1.0, fine),
+				       [&](std::span<const double> x, std::span<double> values)
+				       {
+					 for (size_t i(0); i < x.size(); i++)
+					   values[i] = std::sin(2*pi*x[i]);
+				       });
+  SampledMapping<1> nonuniform_sine(Grid<1>(nodes), [](const double x) { return x; });
+  nonuniform_sine.sample([&](std::span<const double> x, std::span<double> values)
+			 {
+			   for (size_t i(0); i < x.size(); i++)
+			     values[i] = std::sin(2*pi*x[i]);
+			 });
+  cout << "  1D scalar vs. batched: " << linfty_distance(sampled_sine, batched_sine)
+       << ", non-uniform grid: value at x_5=" << nodes[5] << " is " << nonuniform_sine.values()[5] << endl;
+  auto t4 = std::chrono::steady_clock::now();
+  const SampledMapping<2> sampled_product(square, [&](const double x, const double y) { return std::sin(pi*x)*std::sin(pi*y); });
+  auto t5 = std::chrono::steady_clock::now();
+  const SampledMapping<2> batched_curved(curved_grid,
+					 [](std::span<const double> x, std::span<const double> y, std::span<double> values)
+					 {
+					   for (size_t i(0); i < x.size(); i++)
+					     values[i] = x[i]+y[i];
+					 });
+  cout << "  2D: distance to the values sampled above " << linfty_distance(sampled_product, w)
+       << " (" << std::chrono::duration<double, std::milli>(t5-t4).count() << "ms)"
+       << ", curvilinear batched: v(63,63)=" << batched_curved.values()(63,63) << endl;
+  const Array2D<double>& sampled_values(sampled_product.values());
+  bool zero_padding(true);
+  for (size_t n(0); n < sampled_values.column_dimension(); n++)
+    for (size_t m(sampled_values.row_dimension()); m < sampled_values.leading_dimension(); m++)
+      zero_padding = zero_padding && sampled_values.storage_begin()[n*sampled_values.leading_dimension()+m] == 0;
+  cout << "  padding of the sampled values is zero: " << (zero_padding ? "yes" : "no") << endl;
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <utils/slab_pool.h>
+#include <utils/small_array1d.h>
+#include <utils/array1d.h>
+#include <utils/array2d.h>
+
+using std::cout;
+using std::endl;
+using namespace AMSTeL;
+
+int main()
+{
+  cout << "Testing small arrays and the slab pool resource..." << endl;
+
+  SlabPoolResource pool;
+  cout << "- a SlabPoolResource with max_block=" << pool.max_block()
+       << " and " << pool.slabs() << " slabs" << endl;
+
+  Array1D<double> a(5, &pool);
+  a[0] = 1; a[4] = 2;
+  cout << "- a pool-backed Array1D<double> a: " << a << endl;
+  cout << "  (storage from a memory resource: "
+       << (a.storage() == storage_type::memory_resource) << ", resource is the pool: "
+       << (a.resource() == &pool) << ", slabs: " << pool.slabs() << ")" << endl;
+
+  for (int i(0); i < 10; i++)
+    a.push_back(i);
+  cout << "- a after growing: " << a << endl;
+  cout << "  (still from the pool: " << (a.resource() == &pool) << ", slabs: " << pool.slabs() << ")" << endl;
+
+  Array1D<double> b(a);
+  cout << "- a copy b of a lives on the heap: " << (b.storage() == storage_type::aligned_heap) << endl;
+
+  Array1D<double> c(std::move(a));
+  cout << "- c moved from a keeps the pool: " << (c.resource() == &pool)
+       << ", a is empty: " << (a.size() == 0) << endl;
+
+  Array2D<double> m(3, 2, &pool);
+  for (unsigned int i(0); i < m.row_dimension(); i++)
+    for (unsigned int j(0); j < m.column_dimension(); j++)
+      m(i,j) = i+10*j;
+  cout << "- a pool-backed Array2D<double> m:" << endl << m;
+  cout << "  (resource is the pool: " << (m.resource() == &pool) << ")" << endl;
+
+  {
+    const size_t slabs(pool.slabs());
+    for (int i(0); i < 1000; i++)
+      {
+        Array1D<int> mask(8, &pool);
+        mask[i%8] = i;
+      }
+    cout << "- 1000 short-lived masks from the pool need "
+         << pool.slabs()-slabs << " new slab(s)" << endl;
+  }
+
+  {
+    const unsigned int n(200000);
+    auto t0 = std::chrono::steady_clock::now();
+    {
+      std::vector<Array1D<double> > v;
+      v.reserve(n);
+      for (unsigned int i(0); i < n; i++)
+        v.emplace_back(6);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    {
+      SlabPoolResource local_pool;
+      std::vector<Array1D<double> > v;
+      v.reserve(n);
+      for (unsigned int i(0); i < n; i++)
+        v.emplace_back(6, &local_pool);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    cout << "- " << n << " arrays of size 6: "
+         << std::chrono::duration<double, std::milli>(t1-t0).count() << "ms (heap), "
+         << std::chrono::duration<double, std::milli>(t2-t1).count() << "ms (slab pool)" << endl;
+  }
+
+  SmallArray1D<int,4> s;
+  cout << "- an empty SmallArray1D<int,4> s: " << s
+       << " (inline: " << s.is_inline() << ", capacity: " << s.capacity() << ")" << endl;
+  for (int i(1); i <= 4; i++)
+    s.push_back(i);
+  cout << "- s after 4 push_back() calls: " << s << " (inline: " << s.is_inline() << ")" << endl;
+  s.push_back(s[0]);
+  cout << "- s after another push_back(): " << s << " (inline: " << s.is_inline()
+       << ", capacity: " << s.capacity() << ")" << endl;
+
+  SmallArray1D<int,4> t(3);
+  t[2] = 7;
+  cout << "- t: " << t << endl;
+  swap(s, t);
+  cout << "- after swapping, s: " << s << " (inline: " << s.is_inline()
+       << "), t: " << t << " (inline: " << t.is_inline() << ")" << endl;
+
+  SmallArray1D<int,4> u(std::move(t));
+  cout << "- u moved from t: " << u << ", t is empty: " << (t.size() == 0)
+       << " (inline: " << t.is_inline() << ")" << endl;
+  u = s;
+  cout << "- u after assigning s: " << u << endl;
+  u.resize(1);
+  cout << "- u after resize(1): " << u << endl;
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <filesystem>
+#include <algebra/infinite_vector.h>
+#include <io/snapshot_writer.h>
+
+using std::cout;
+using std::endl;
+using namespace AMSTeL;
+
+int main()
+{
+  cout << "Testing the SnapshotWriter class..." << endl;
+
+  const std::string prefix
+    ((std::filesystem::temp_directory_path() / "amstel_snapshot_").string());
+
+  {
+    SnapshotWriter<InfiniteVector<double,int> > writer;
+    InfiniteVector<double,int> v;
+    for (int step(0); step < 5; step++)
+      {
+        v[step] = step+1;
+        std::ostringstream filename;
+        filename << prefix << step << ".txt";
+        writer.write(v, filename.str()); // copy, v is reused
+      }
+    writer.flush();
+    cout << "- pending snapshots after flush(): " << writer.pending() << endl;
+    cout << "- failed writes: " << writer.failures() << endl;
+
+    InfiniteVector<double,int> w(v);
+    if (writer.try_write(std::move(w), prefix + "moved.txt"))
+      cout << "- try_write() accepted a moved snapshot" << endl;
+  } // destructor writes all pending snapshots
+
+  cout << "- contents of the last snapshot:" << endl;
+  std::ifstream ifs((prefix + "4.txt").c_str());
+  cout << ifs.rdbuf();
+  ifs.close();
+
+  cout << "- a writer with a custom formatter and a nonexistent target:" << endl;
+  {
+    SnapshotWriter<InfiniteVector<double,int> >
+      writer([](std::ostream& os, const InfiniteVector<double,int>& v) { os << v.size() << endl; }, 1);
+    writer.write(InfiniteVector<double,int>(), "/nonexistent/directory/snapshot.txt");
+    writer.flush();
+    cout << "  failed writes: " << writer.failures() << endl;
+  }
+
+  cout << "- a writer with a throwing formatter:" << endl;
+  {
+    SnapshotWriter<InfiniteVector<double,int> >
+      writer([](std::ostream&, const InfiniteVector<double,int>& v)
+             {
+               if (v.size() == 0)
+                 throw std::runtime_error("empty snapshot");
+             }, 1);
+    writer.write(InfiniteVector<double,int>(), prefix + "throwing.txt");
+    InfiniteVector<double,int> v;
+    v[0] = 1.0;
+    writer.write(v, prefix + "throwing.txt");
+    const bool success(writer.flush());
+    cout << "  flush() succeeded: " << success << ", failed writes: " << writer.failures()
+         << ", pending: " << writer.pending() << endl;
+  }
+  std::filesystem::remove(prefix + "throwing.txt");
+
+  for (int step(0); step < 5; step++)
+    std::filesystem::remove(prefix + std::to_string(step) + ".txt");
+  std::filesystem::remove(prefix + "moved.txt");
+
+  return 0;
+}
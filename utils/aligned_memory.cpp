@@ -0,0 +1,56 @@
+// implementation for aligned_memory.h
+
+#include <new>
+#include <memory>
+#include <type_traits>
+#include "utils/parallel_for.h"
+
+namespace AMSTeL
+{
+  template <class C>
+  inline
+  C* allocate_aligned(const size_t n)
+  {
+    if (n == 0)
+      return 0;
+    return static_cast<C*>(::operator new(n*sizeof(C), std::align_val_t(array_alignment<C>())));
+  }
+
+  template <class C>
+  inline
+  void deallocate_aligned(C* p)
+  {
+    if (p != 0)
+      ::operator delete(static_cast<void*>(p), std::align_val_t(array_alignment<C>()));
+  }
+
+  template <class C>
+  void first_touch_construct(C* p, const size_t n)
+  {
+    if constexpr (std::is_nothrow_default_constructible_v<C>)
+      {
+        const size_t page_size(4096);
+        parallel_for(0, n, [p](const size_t begin, const size_t end, const unsigned int)
+                     {
+                       std::uninitialized_value_construct_n(p+begin, end-begin);
+                     }, sizeof(C) < page_size ? page_size/sizeof(C) : 1);
+      }
+    else
+      std::uninitialized_value_construct_n(p, n);
+  }
+
+  template <class C>
+  inline
+  size_t padded_length(const size_t n)
+  {
+    if constexpr (array_alignment<C>() % sizeof(C) != 0)
+      return n; // C does not fit into the alignment units
+    else
+      {
+        const size_t unit(array_alignment<C>() / sizeof(C));
+        if (n <= unit)
+          return n;
+        return ((n + unit - 1) / unit) * unit;
+      }
+  }
+}
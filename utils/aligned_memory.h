@@ -0,0 +1,93 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_ALIGNED_MEMORY_H
+#define _AMSTEL_ALIGNED_MEMORY_H
+
+#include <cstddef>
+
+/*!
+  alignment (in bytes) of the storage of Array1D and Array2D,
+  defaults to the cache line size of current x86 and ARM processors;
+  can be overridden at compile time, e.g., -DAMSTEL_ALIGNMENT=128
+*/
+#ifndef AMSTEL_ALIGNMENT
+#define AMSTEL_ALIGNMENT 64
+#endif
+
+namespace AMSTeL
+{
+  /*!
+    alignment (in bytes) of aligned storage for objects of type C
+  */
+  template <class C>
+  constexpr size_t array_alignment()
+  {
+    return AMSTEL_ALIGNMENT > alignof(C) ? AMSTEL_ALIGNMENT : alignof(C);
+  }
+
+  /*!
+    tag type for array constructors and resize() routines,
+    requesting that new entries of trivially default constructible types C
+    are left uninitialized (all other types C are default constructed)
+  */
+  struct no_initialization_t {};
+  inline constexpr no_initialization_t no_initialization{};
+
+  /*!
+    tag type for array constructors and resize() routines,
+    requesting that new entries are value-initialized in parallel
+    (page-sized chunks at least, cf. parallel_for()), such that the pages are
+    first touched by several threads instead of the calling thread alone
+    (on NUMA systems, the operating system places a page on the node of the
+    first touching thread; since the threads are not pinned, this spreads the
+    array over the nodes, but does not tie a page to the threads processing it later)
+  */
+  struct first_touch_t {};
+  inline constexpr first_touch_t first_touch{};
+
+  /*!
+    allocate uninitialized storage for n objects of type C,
+    aligned to array_alignment<C>() bytes (n=0 yields a null pointer)
+  */
+  template <class C>
+  C* allocate_aligned(const size_t n);
+
+  /*!
+    release storage allocated by allocate_aligned()
+    (the objects have to be destroyed before)
+  */
+  template <class C>
+  void deallocate_aligned(C* p);
+
+  /*!
+    value-initialize the n objects of type C at p in parallel,
+    using the static partition of parallel_for() with at least one memory page
+    per thread (for large n, the chunks coincide with those of all parallel
+    algorithms of the library); types C with a throwing default constructor
+    are initialized serially
+  */
+  template <class C>
+  void first_touch_construct(C* p, const size_t n);
+
+  /*!
+    Length to which a contiguous block of n objects of type C is padded,
+    such that consecutive blocks start on aligned boundaries.
+    Blocks shorter than one alignment unit are not padded,
+    since the relative memory overhead would be too large.
+  */
+  template <class C>
+  size_t padded_length(const size_t n);
+}
+
+#include "utils/aligned_memory.cpp"
+
+#endif
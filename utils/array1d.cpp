@@ -2,6 +2,9 @@
 
 #include <cassert>
 #include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
 #include "io/vector_io.h"
 
 namespace AMSTeL
@@ -9,42 +12,135 @@ namespace AMSTeL
   template <class C>
   inline
   Array1D<C>::Array1D()
-    : data_(0), size_(0)
+    : data_(0), size_(0), capacity_(0), storage_(storage_type::aligned_heap), resource_(0)
   {
   }
 
   template <class C>
   inline
   Array1D<C>::Array1D(const size_type s)
-    : size_(s)
+    : data_(0), size_(0), capacity_(0), storage_(storage_type::aligned_heap), resource_(0)
   {
-    if (s == 0)
-      data_ = 0;
-    else
-      {
-        data_ = new C[s]; // calls C()
-      }
+    data_ = allocate_aligned<C>(s);
+    capacity_ = s;
+    std::uninitialized_value_construct_n(data_, s); // calls C()
+    size_ = s;
+  }
+
+  template <class C>
+  inline
+  Array1D<C>::Array1D(const size_type s, no_initialization_t)
+    : data_(0), size_(0), capacity_(0), storage_(storage_type::aligned_heap), resource_(0)
+  {
+    data_ = allocate_aligned<C>(s);
+    capacity_ = s;
+    std::uninitialized_default_construct_n(data_, s); // no-op for trivial types C
+    size_ = s;
+  }
+
+  template <class C>
+  inline
+  Array1D<C>::Array1D(const size_type s, first_touch_t)
+    : data_(0), size_(0), capacity_(0), storage_(storage_type::aligned_heap), resource_(0)
+  {
+    data_ = allocate_aligned<C>(s);
+    capacity_ = s;
+    first_touch_construct(data_, s);
+    size_ = s;
+  }
+
+  template <class C>
+  inline
+  Array1D<C>::Array1D(const size_type s, huge_pages_t)
+    : data_(0), size_(0), capacity_(0), storage_(storage_type::huge_pages), resource_(0)
+  {
+    data_ = allocate_storage<C>(s, storage_, resource_);
+    capacity_ = s;
+    std::uninitialized_value_construct_n(data_, s); // calls C()
+    size_ = s;
+  }
+
+  template <class C>
+  inline
+  Array1D<C>::Array1D(const size_type s, std::pmr::memory_resource* resource)
+    : data_(0), size_(0), capacity_(0), storage_(storage_type::memory_resource), resource_(resource)
+  {
+    data_ = allocate_storage<C>(s, storage_, resource_);
+    capacity_ = s;
+    std::uninitialized_value_construct_n(data_, s); // calls C()
+    size_ = s;
   }
 
   template <class C>
   inline
   Array1D<C>::Array1D(const Array1D<C>& a)
-    : size_(a.size())
+    : data_(0), size_(0), capacity_(0), storage_(storage_type::aligned_heap), resource_(0)
   {
-    if (size_ == 0)
-      data_ = 0;
-    else
+    data_ = allocate_aligned<C>(a.size_);
+    capacity_ = a.size_;
+    std::uninitialized_copy(a.data_, a.data_+a.size_, data_);
+    size_ = a.size_;
+  }
+
+  template <class C>
+  inline
+  Array1D<C>::Array1D(Array1D<C>&& a) noexcept
+    : data_(a.data_), size_(a.size_), capacity_(a.capacity_), storage_(a.storage_), resource_(a.resource_)
+  {
+    a.data_ = 0;
+    a.size_ = 0;
+    a.capacity_ = 0;
+    a.storage_ = reallocation_type(a.storage_);
+  }
+
+  template <class C>
+  Array1D<C>& Array1D<C>::operator = (const Array1D<C>& a)
+  {
+    if (this != &a)
       {
-        data_ = new C[size_];
-        std::copy(a.begin(), a.end(), begin());
+        if (a.size_ > capacity_)
+          {
+            // no need to preserve the old entries
+            Array1D<C> help(a);
+            swap(help);
+          }
+        else
+          {
+            if (a.size_ <= size_)
+              {
+                std::copy(a.data_, a.data_+a.size_, data_);
+                std::destroy(data_+a.size_, data_+size_);
+              }
+            else
+              {
+                std::copy(a.data_, a.data_+size_, data_);
+                std::uninitialized_copy(a.data_+size_, a.data_+a.size_, data_+size_);
+              }
+            size_ = a.size_;
+          }
       }
+
+    return *this;
   }
 
   template <class C>
-  Array1D<C>& Array1D<C>::operator = (const Array1D<C>& a)
+  inline
+  Array1D<C>& Array1D<C>::operator = (Array1D<C>&& a) noexcept
   {
-    resize(a.size());
-    std::copy(a.begin(), a.end(), begin());
+    if (this != &a)
+      {
+        std::destroy_n(data_, size_);
+        release_storage(data_, capacity_, storage_, resource_);
+        data_ = a.data_;
+        size_ = a.size_;
+        capacity_ = a.capacity_;
+        storage_ = a.storage_;
+        resource_ = a.resource_;
+        a.data_ = 0;
+        a.size_ = 0;
+        a.capacity_ = 0;
+        a.storage_ = reallocation_type(a.storage_);
+      }
 
     return *this;
   }
@@ -53,7 +149,8 @@ namespace AMSTeL
   inline
   Array1D<C>::~Array1D()
   {
-    if (data_ != 0) delete [] data_;
+    std::destroy_n(data_, size_);
+    release_storage(data_, capacity_, storage_, resource_);
     size_ = 0;
   }
   
@@ -65,24 +162,182 @@ namespace AMSTeL
     return size_;
   }
 
+  template <class C>
+  inline
+  const typename Array1D<C>::size_type
+  Array1D<C>::capacity() const
+  {
+    return capacity_;
+  }
+
+  template <class C>
+  void Array1D<C>::reallocate(const size_type s)
+  {
+    assert(s >= size_);
+
+    const storage_type type(reallocation_type(storage_));
+    C* data = allocate_storage<C>(s, type, resource_);
+    for (size_type i(0); i < size_; i++)
+      ::new (static_cast<void*>(data+i)) C(std::move_if_noexcept(data_[i]));
+    std::destroy_n(data_, size_);
+    release_storage(data_, capacity_, storage_, resource_);
+    data_ = data;
+    capacity_ = s;
+    storage_ = type;
+  }
+
+  template <class C>
+  inline
+  storage_type Array1D<C>::storage() const
+  {
+    return storage_;
+  }
+
+  template <class C>
+  inline
+  std::pmr::memory_resource* Array1D<C>::resource() const
+  {
+    return resource_;
+  }
+
+  template <class C>
+  bool Array1D<C>::map_file(const std::string& filename, const file_access access)
+  {
+    return map_file(filename, access, size_type(-1));
+  }
+
+  template <class C>
+  bool Array1D<C>::map_file(const std::string& filename, const file_access access,
+                            const size_type s)
+  {
+    size_type n(s);
+    C* data(0);
+    if (!map_file_storage(filename, access, n, data))
+      return false;
+
+    // the entries are trivially copyable and live in the file
+    std::destroy_n(data_, size_);
+    release_storage(data_, capacity_, storage_, resource_);
+    data_ = data;
+    size_ = n;
+    capacity_ = n;
+    storage_ = (access == file_access::read_write
+                ? storage_type::shared_file
+                : storage_type::private_file);
+    resource_ = 0;
+    return true;
+  }
+
+  template <class C>
+  inline
+  typename Array1D<C>::size_type
+  Array1D<C>::grown_capacity(const size_type s) const
+  {
+    return std::max(s, 2*capacity_);
+  }
+
+  template <class C>
+  void Array1D<C>::reserve(const size_type s)
+  {
+    if (s > capacity_)
+      reallocate(s);
+  }
+
   template <class C>
   void Array1D<C>::resize(const size_type s)
   {
-    if (s == 0)
+    if (s > size_)
       {
-        if (data_ != 0) {
-          delete [] data_;
-          data_ = 0;
-        }
-      	size_ = 0;
+        if (s > capacity_)
+          reallocate(grown_capacity(s));
+        std::uninitialized_value_construct(data_+size_, data_+s); // calls C()
       }
     else
+      std::destroy(data_+s, data_+size_);
+    size_ = s;
+  }
+
+  template <class C>
+  void Array1D<C>::resize(const size_type s, no_initialization_t)
+  {
+    if (s > size_)
+      {
+        if (s > capacity_)
+          reallocate(grown_capacity(s));
+        std::uninitialized_default_construct(data_+size_, data_+s); // no-op for trivial types C
+      }
+    else
+      std::destroy(data_+s, data_+size_);
+    size_ = s;
+  }
+
+  template <class C>
+  void Array1D<C>::resize(const size_type s, first_touch_t)
+  {
+    if (s > size_)
       {
-        if (size_ != s) {
-          if (data_ != 0) delete [] data_;
-          data_ = new C[s]; // calls C()
-          size_ = s;
-        }
+        if (s > capacity_)
+          reallocate(grown_capacity(s));
+        first_touch_construct(data_+size_, s-size_);
+      }
+    else
+      std::destroy(data_+s, data_+size_);
+    size_ = s;
+  }
+
+  template <class C>
+  inline
+  void Array1D<C>::push_back(const C& x)
+  {
+    emplace_back(x);
+  }
+
+  template <class C>
+  inline
+  void Array1D<C>::push_back(C&& x)
+  {
+    emplace_back(std::move(x));
+  }
+
+  template <class C>
+  template <class... ARGS>
+  inline
+  C& Array1D<C>::emplace_back(ARGS&&... args)
+  {
+    if (size_ < capacity_)
+      ::new (static_cast<void*>(data_+size_)) C(std::forward<ARGS>(args)...);
+    else
+      {
+        // construct the new entry first, the arguments may refer to old entries
+        const size_type capacity(grown_capacity(size_+1));
+        const storage_type type(reallocation_type(storage_));
+        C* data = allocate_storage<C>(capacity, type, resource_);
+        ::new (static_cast<void*>(data+size_)) C(std::forward<ARGS>(args)...);
+        for (size_type i(0); i < size_; i++)
+          ::new (static_cast<void*>(data+i)) C(std::move_if_noexcept(data_[i]));
+        std::destroy_n(data_, size_);
+        release_storage(data_, capacity_, storage_, resource_);
+        data_ = data;
+        capacity_ = capacity;
+        storage_ = type;
+      }
+    return data_[size_++];
+  }
+
+  template <class C>
+  void Array1D<C>::shrink_to_fit()
+  {
+    // file-backed arrays keep their mapping
+    if (capacity_ > size_ && reallocation_type(storage_) == storage_)
+      {
+        if (size_ == 0)
+          {
+            release_storage(data_, capacity_, storage_, resource_);
+            data_ = 0;
+            capacity_ = 0;
+          }
+        else
+          reallocate(size_);
       }
   }
 
@@ -136,9 +391,27 @@ namespace AMSTeL
 
   template <class C>
   inline
-  void Array1D<C>::swap(Array1D<C>& a)
+  const C* Array1D<C>::aligned_data() const
+  {
+    return std::assume_aligned<array_alignment<C>()>(data_);
+  }
+
+  template <class C>
+  inline
+  C* Array1D<C>::aligned_data()
+  {
+    return std::assume_aligned<array_alignment<C>()>(data_);
+  }
+
+  template <class C>
+  inline
+  void Array1D<C>::swap(Array1D<C>& a) noexcept
   {
     std::swap(data_, a.data_);
+    std::swap(size_, a.size_);
+    std::swap(capacity_, a.capacity_);
+    std::swap(storage_, a.storage_);
+    std::swap(resource_, a.resource_);
   }
 
   template <class C>
@@ -153,6 +426,13 @@ namespace AMSTeL
     data_[j] = tmp;
   }
 
+  template <class C>
+  inline
+  void swap(Array1D<C>& a, Array1D<C>& b) noexcept
+  {
+    a.swap(b);
+  }
+
   template <class C>
   inline
   std::ostream& operator << (std::ostream& os, const Array1D<C>& a)
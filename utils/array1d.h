@@ -13,6 +13,9 @@
 #define _AMSTEL_ARRAY1D_H
 
 #include <iostream>
+#include <string>
+#include "utils/aligned_memory.h"
+#include "utils/mapped_storage.h"
 
 namespace AMSTeL
 {
@@ -22,6 +25,7 @@ namespace AMSTeL
     Array1D<C> has the same interface as std::vector<C>, but it is much
     faster in practice due to the internal storage format.
     Even compared with a std::valarray<C>, one may gain a bit of performance.
+    The storage is aligned to array_alignment<C>() bytes (cache lines by default).
   */
   template <class C>
   class Array1D
@@ -76,15 +80,45 @@ namespace AMSTeL
       copy constructor
     */
     Array1D(const Array1D<C>& a);
+
+    /*!
+      move constructor, takes over the storage of a and leaves a empty
+    */
+    Array1D(Array1D<C>&& a) noexcept;
     
     /*!
-      Construct an array of positive size s.
-      Warning: the builtin types (int, double, ...) may _not_
-      automatically be set to _zero_, this may depend on the
-      compiler and on the compiler options!
+      Construct an array of size s, the entries are value-initialized
+      (i.e., builtin types (int, double, ...) are set to zero).
     */
     explicit Array1D(const size_type s);
 
+    /*!
+      Construct an array of size s without initializing the entries,
+      if C is trivially default constructible (opt-in for performance-critical code).
+    */
+    Array1D(const size_type s, no_initialization_t);
+
+    /*!
+      Construct an array of size s, the entries are value-initialized
+      in parallel (first touch, cf. first_touch_t).
+    */
+    Array1D(const size_type s, first_touch_t);
+
+    /*!
+      Construct an array of size s, backed by huge pages (cf. huge_pages_t),
+      the entries are value-initialized.
+    */
+    Array1D(const size_type s, huge_pages_t);
+
+    /*!
+      Construct an array of size s, the storage of which is obtained from
+      the given memory resource (e.g., a SlabPoolResource for many small arrays),
+      the entries are value-initialized. The array stays with the resource when
+      it grows; the resource has to outlive the array. Copies of the array
+      allocate from the heap.
+    */
+    Array1D(const size_type s, std::pmr::memory_resource* resource);
+
     /*!
       release allocated memory
     */
@@ -96,18 +130,67 @@ namespace AMSTeL
     const size_type size() const;
 
     /*!
-      Resize the array to length s.
-      Warning: the builtin types (int, double, ...) may _not_
-      automatically be set to _zero_, this may depend on the
-      compiler and on the compiler options!
+      number of entries for which storage has been allocated
+    */
+    const size_type capacity() const;
+
+    /*!
+      Allocate storage for at least s entries, keeping the current entries.
+    */
+    void reserve(const size_type s);
+
+    /*!
+      Resize the array to length s, keeping the first min(s,size()) entries.
+      New entries are value-initialized (i.e., builtin types are set to zero).
+      Reallocations only happen if s exceeds capacity(), and then the capacity
+      grows geometrically, so that repeated resizing has amortized linear cost.
     */
     void resize(const size_type s);
 
+    /*!
+      Resize the array to length s, keeping the first min(s,size()) entries,
+      new entries of trivially default constructible types C are left uninitialized.
+    */
+    void resize(const size_type s, no_initialization_t);
+
+    /*!
+      Resize the array to length s, keeping the first min(s,size()) entries,
+      new entries are value-initialized in parallel (first touch, cf. first_touch_t).
+    */
+    void resize(const size_type s, first_touch_t);
+
+    /*!
+      append an entry at the end of the array (amortized constant complexity)
+    */
+    void push_back(const C& x);
+
+    /*!
+      append an entry at the end of the array (amortized constant complexity)
+    */
+    void push_back(C&& x);
+
+    /*!
+      construct an entry in place at the end of the array
+      (amortized constant complexity)
+    */
+    template <class... ARGS>
+    C& emplace_back(ARGS&&... args);
+
+    /*!
+      release unused storage, such that capacity() == size()
+    */
+    void shrink_to_fit();
+
     /*!
       assignment operator
     */
     Array1D<C>& operator = (const Array1D<C>& a);
 
+    /*!
+      move assignment, takes over the storage of a and leaves a empty
+    */
+    Array1D<C>& operator = (Array1D<C>&& a) noexcept;
+
     /*!
       read-only access to the i-th array member
     */
@@ -141,18 +224,59 @@ namespace AMSTeL
     iterator end();
 
     /*!
-      swap components of two arrays
+      read-only access to the internal storage, the alignment of which
+      is made known to the compiler (cf. std::assume_aligned)
+    */
+    const C* aligned_data() const;
+
+    /*!
+      read-write access to the internal storage, the alignment of which
+      is made known to the compiler (cf. std::assume_aligned)
     */
-    void swap (Array1D<C>& a);
+    C* aligned_data();
+
+    /*!
+      swap components of two arrays (without any allocation)
+    */
+    void swap (Array1D<C>& a) noexcept;
 
     /*!
       swap two entries of an array
     */
     void swap (const size_type i, const size_type j);
 
+    /*!
+      origin of the internal storage (heap, huge pages or a mapped file)
+    */
+    storage_type storage() const;
+
+    /*!
+      memory resource providing the internal storage
+      (0 unless storage() == storage_type::memory_resource)
+    */
+    std::pmr::memory_resource* resource() const;
+
+    /*!
+      Replace the contents of the array by the whole binary file filename,
+      which is mapped into memory (entries are loaded on demand by the operating system).
+      Only for trivially copyable C. Returns false if the file cannot be mapped.
+      Growing the array beyond its size later on detaches it from the file
+      (the entries are copied to heap memory).
+    */
+    bool map_file(const std::string& filename, const file_access access);
+
+    /*!
+      Replace the contents of the array by the first s entries of the binary file
+      filename, which is mapped into memory; for read_write, the file is
+      created or extended if necessary.
+      Only for trivially copyable C. Returns false if the file cannot be mapped.
+    */
+    bool map_file(const std::string& filename, const file_access access,
+                  const size_type s);
+
   protected:
     /*!
-      internal storage is just a pointer to a C array
+      internal storage is just a pointer to an aligned C array
     */
     C* data_;
 
@@ -160,8 +284,40 @@ namespace AMSTeL
       size of the array
     */
     size_type size_;
+
+    /*!
+      number of entries for which storage has been allocated
+    */
+    size_type capacity_;
+
+    /*!
+      origin of the internal storage
+    */
+    storage_type storage_;
+
+    /*!
+      memory resource for storage_type::memory_resource
+    */
+    std::pmr::memory_resource* resource_;
+
+  private:
+    /*!
+      move the entries into new storage for s >= size() entries
+    */
+    void reallocate(const size_type s);
+
+    /*!
+      capacity needed for at least s entries, with geometric growth
+    */
+    size_type grown_capacity(const size_type s) const;
   };
 
+  /*!
+    swap the contents of two arrays (without any allocation)
+  */
+  template <class C>
+  void swap(Array1D<C>& a, Array1D<C>& b) noexcept;
+
   /*!
     Matlab-style stream output for arrays
    */
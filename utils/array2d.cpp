@@ -1,190 +1,639 @@
-// implementation of some (inline) Array2D<C>:: methods
+// implementation of some (inline) Array2D<C,LAYOUT>:: methods
 
 #include <cassert>
 #include <algorithm>
 #include <iomanip>
+#include <memory>
 #include "io/matrix_io.h"
 
 namespace AMSTeL
 {
-  template <class C>
+  template <class T, class LAYOUT>
   inline
-  Array2D<C>::Array2D()
-    : data_(0), size_(0), coldim_(0), rowdim_(0)
+  Array2DIterator<T,LAYOUT>::Array2DIterator()
+    : data_(0), rows_(0), ld_(0), index_(0)
   {
   }
 
-  template <class C>
+  template <class T, class LAYOUT>
   inline
-  Array2D<C>::Array2D(const size_type s)
-    : size_(s*s),coldim_(s),rowdim_(s)
+  Array2DIterator<T,LAYOUT>::Array2DIterator(T* data, const size_t rows, const size_t ld,
+                                             const size_t index)
+    : data_(data), rows_(rows), ld_(ld), index_(index)
   {
-    if (s == 0)
-      data_ = 0;
-    else
-      {
-        data_ = new C[s*s]; // calls C()
-      }
   }
 
-  template <class C>
+  template <class T, class LAYOUT>
   inline
-  Array2D<C>::Array2D(const size_type row,const size_type col)
-    : size_(col*row),coldim_(col),rowdim_(row)
+  Array2DIterator<T,LAYOUT>::operator Array2DIterator<const T,LAYOUT> () const
   {
-    if (col*row == 0)
-      data_ = 0;
-    else
-      {
-        data_ = new C[col*row]; // calls C()
-      }
+    return Array2DIterator<const T,LAYOUT>(data_, rows_, ld_, index_);
   }
 
-  template <class C>
+  template <class T, class LAYOUT>
   inline
-  Array2D<C>::Array2D(const Array2D<C>& a)
-    : size_(a.size()),rowdim_(a.rowdim_), coldim_(a.coldim_)
+  typename Array2DIterator<T,LAYOUT>::reference
+  Array2DIterator<T,LAYOUT>::operator * () const
   {
-    if (size_ == 0)
-      data_ = 0;
-    else
+    return data_[LAYOUT::index(index_ % rows_, index_ / rows_, ld_)];
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  typename Array2DIterator<T,LAYOUT>::pointer
+  Array2DIterator<T,LAYOUT>::operator -> () const
+  {
+    return &**this;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  typename Array2DIterator<T,LAYOUT>::reference
+  Array2DIterator<T,LAYOUT>::operator [] (const difference_type n) const
+  {
+    return *(*this + n);
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>&
+  Array2DIterator<T,LAYOUT>::operator ++ ()
+  {
+    ++index_;
+    return *this;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>
+  Array2DIterator<T,LAYOUT>::operator ++ (int)
+  {
+    Array2DIterator<T,LAYOUT> r(*this);
+    ++index_;
+    return r;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>&
+  Array2DIterator<T,LAYOUT>::operator -- ()
+  {
+    --index_;
+    return *this;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>
+  Array2DIterator<T,LAYOUT>::operator -- (int)
+  {
+    Array2DIterator<T,LAYOUT> r(*this);
+    --index_;
+    return r;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>&
+  Array2DIterator<T,LAYOUT>::operator += (const difference_type n)
+  {
+    index_ += n;
+    return *this;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>&
+  Array2DIterator<T,LAYOUT>::operator -= (const difference_type n)
+  {
+    index_ -= n;
+    return *this;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>
+  Array2DIterator<T,LAYOUT>::operator + (const difference_type n) const
+  {
+    return Array2DIterator<T,LAYOUT>(data_, rows_, ld_, index_+n);
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>
+  Array2DIterator<T,LAYOUT>::operator - (const difference_type n) const
+  {
+    return Array2DIterator<T,LAYOUT>(data_, rows_, ld_, index_-n);
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  typename Array2DIterator<T,LAYOUT>::difference_type
+  Array2DIterator<T,LAYOUT>::operator - (const Array2DIterator<T,LAYOUT>& it) const
+  {
+    return difference_type(index_) - difference_type(it.index_);
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  bool
+  Array2DIterator<T,LAYOUT>::operator == (const Array2DIterator<T,LAYOUT>& it) const
+  {
+    return index_ == it.index_;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  std::strong_ordering
+  Array2DIterator<T,LAYOUT>::operator <=> (const Array2DIterator<T,LAYOUT>& it) const
+  {
+    return index_ <=> it.index_;
+  }
+
+  template <class T, class LAYOUT>
+  inline
+  Array2DIterator<T,LAYOUT>
+  operator + (const typename Array2DIterator<T,LAYOUT>::difference_type n,
+              const Array2DIterator<T,LAYOUT>& it)
+  {
+    return it + n;
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D()
+    : data_(0), coldim_(0), rowdim_(0), size_(0), ld_(0),
+      storage_(storage_type::aligned_heap), resource_(0)
+  {
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D(const size_type s)
+    : data_(0), coldim_(0), rowdim_(0), size_(0), ld_(0),
+      storage_(storage_type::aligned_heap), resource_(0)
+  {
+    allocate(s, s);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D(const size_type row,const size_type col)
+    : data_(0), coldim_(0), rowdim_(0), size_(0), ld_(0),
+      storage_(storage_type::aligned_heap), resource_(0)
+  {
+    allocate(row, col);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D(const size_type row, const size_type col, first_touch_t)
+    : data_(0), coldim_(0), rowdim_(0), size_(0), ld_(0),
+      storage_(storage_type::aligned_heap), resource_(0)
+  {
+    allocate(row, col, initialization::first_touch);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D(const size_type row, const size_type col, no_initialization_t)
+    : data_(0), coldim_(0), rowdim_(0), size_(0), ld_(0),
+      storage_(storage_type::aligned_heap), resource_(0)
+  {
+    allocate(row, col, initialization::none);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D(const size_type row, const size_type col, huge_pages_t)
+    : data_(0), coldim_(0), rowdim_(0), size_(0), ld_(0),
+      storage_(storage_type::huge_pages), resource_(0)
+  {
+    allocate(row, col);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D(const size_type row, const size_type col,
+                             std::pmr::memory_resource* resource)
+    : data_(0), coldim_(0), rowdim_(0), size_(0), ld_(0),
+      storage_(storage_type::memory_resource), resource_(resource)
+  {
+    allocate(row, col);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D(const Array2D<C,LAYOUT>& a)
+    : data_(0), coldim_(0), rowdim_(0), size_(0), ld_(0),
+      storage_(storage_type::aligned_heap), resource_(0)
+  {
+    // the copy is padded even if a is not (e.g., a file-backed array)
+    allocate(a.rowdim_, a.coldim_);
+    copy_entries(a);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>::Array2D(Array2D<C,LAYOUT>&& a) noexcept
+    : data_(a.data_), coldim_(a.coldim_), rowdim_(a.rowdim_), size_(a.size_), ld_(a.ld_),
+      storage_(a.storage_), resource_(a.resource_)
+  {
+    a.data_ = 0;
+    a.coldim_ = 0;
+    a.rowdim_ = 0;
+    a.size_ = 0;
+    a.ld_ = 0;
+    a.storage_ = reallocation_type(a.storage_);
+  }
+
+  template <class C, class LAYOUT>
+  Array2D<C,LAYOUT>& Array2D<C,LAYOUT>::operator = (const Array2D<C,LAYOUT>& a)
+  {
+    if (this != &a)
       {
-        data_ = new C[size_];
-        std::copy(a.begin(), a.end(), begin());
+        resize(a.row_dimension(), a.column_dimension());
+        copy_entries(a);
       }
+
+    return *this;
   }
 
-  template <class C>
-  Array2D<C>& Array2D<C>::operator = (const Array2D<C>& a)
+  template <class C, class LAYOUT>
+  inline
+  Array2D<C,LAYOUT>& Array2D<C,LAYOUT>::operator = (Array2D<C,LAYOUT>&& a) noexcept
   {
-    resize(a.row_dimension(), a.column_dimension());
-    std::copy(a.begin(), a.end(), begin());
-    rowdim_=a.rowdim_;
-    coldim_=a.coldim_;
+    if (this != &a)
+      {
+        deallocate();
+        swap(a);
+      }
 
     return *this;
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  Array2D<C>::~Array2D()
+  Array2D<C,LAYOUT>::~Array2D()
+  {
+    deallocate();
+  }
+
+  template <class C, class LAYOUT>
+  void Array2D<C,LAYOUT>::allocate(const size_type row, const size_type col,
+                                   const initialization init)
+  {
+    deallocate();
+
+    const size_type ld(LAYOUT::template leading_dimension<C>(row, col));
+    const size_type storage(LAYOUT::storage_size(row, col, ld));
+    data_ = allocate_storage<C>(storage, storage_, resource_);
+    if (init == initialization::first_touch)
+      first_touch_construct(data_, storage); // value-initializes the padding as well
+    else
+      std::uninitialized_default_construct_n(data_, storage); // calls C(), no-op for trivial types C
+    rowdim_ = row;
+    coldim_ = col;
+    size_ = row*col;
+    ld_ = ld;
+
+    // the padding entries are zero
+    if (init == initialization::serial && storage > size_)
+      LAYOUT::clear_padding(data_, rowdim_, coldim_, ld_);
+  }
+
+  template <class C, class LAYOUT>
+  void Array2D<C,LAYOUT>::deallocate()
   {
-    if (data_ != 0) delete [] data_;
+    std::destroy_n(data_, storage_size());
+    release_storage(data_, storage_size(), storage_, resource_);
+    storage_ = reallocation_type(storage_);
+    data_ = 0;
     size_ = 0;
-    rowdim_=0;
-    coldim_=0;
+    rowdim_ = 0;
+    coldim_ = 0;
+    ld_ = 0;
   }
   
-  template <class C>
+  template <class C, class LAYOUT>
+  void Array2D<C,LAYOUT>::copy_entries(const Array2D<C,LAYOUT>& a)
+  {
+    assert(rowdim_ == a.rowdim_ && coldim_ == a.coldim_);
+    if (ld_ == a.ld_)
+      std::copy(a.storage_begin(), a.storage_end(), storage_begin()); // same storage scheme, including the padding
+    else
+      for (size_type col(0); col < coldim_; col++)
+        for (size_type row(0); row < rowdim_; row++)
+          (*this)(row,col) = a(row,col);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  storage_type Array2D<C,LAYOUT>::storage() const
+  {
+    return storage_;
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  std::pmr::memory_resource* Array2D<C,LAYOUT>::resource() const
+  {
+    return resource_;
+  }
+
+  template <class C, class LAYOUT>
+  bool Array2D<C,LAYOUT>::map_file(const std::string& filename,
+                                   const size_type row, const size_type col,
+                                   const file_access access)
+  {
+    const size_type ld(LAYOUT::packed_leading_dimension(row, col));
+    size_type n(LAYOUT::storage_size(row, col, ld));
+    C* data(0);
+    if (!map_file_storage(filename, access, n, data))
+      return false;
+
+    deallocate();
+    data_ = data;
+    rowdim_ = row;
+    coldim_ = col;
+    size_ = row*col;
+    ld_ = ld;
+    storage_ = (access == file_access::read_write
+                ? storage_type::shared_file
+                : storage_type::private_file);
+    resource_ = 0;
+    return true;
+  }
+
+  template <class C, class LAYOUT>
   inline
-  const typename Array2D<C>::size_type
-  Array2D<C>::size() const
+  const typename Array2D<C,LAYOUT>::size_type
+  Array2D<C,LAYOUT>::size() const
   {
     return size_;
   }
 
-  template <class C>
-  void Array2D<C>::resize(const size_type row,const size_type col)
+  template <class C, class LAYOUT>
+  void Array2D<C,LAYOUT>::resize(const size_type row,const size_type col)
   {
-    rowdim_= row;
-    coldim_= col;
-    size_type s=col*row;
-    if (s == 0)
-      {
-        if (data_ != 0) {
-          delete [] data_;
-          data_ = 0;
-        }
-      	size_ = 0;
-      }
-    else
-      {
-        if (size_ != s) {
-          if (data_ != 0) delete [] data_;
-          data_ = new C[s]; // calls C()
-          size_ = s;
-        }
-      }
+    if (row != rowdim_ || col != coldim_)
+      allocate(row, col);
+  }
+
+  template <class C, class LAYOUT>
+  void Array2D<C,LAYOUT>::resize(const size_type row, const size_type col, first_touch_t)
+  {
+    allocate(row, col, initialization::first_touch);
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  const C& Array2D<C>::operator () (const size_type row, const size_type col) const
+  const C& Array2D<C,LAYOUT>::operator () (const size_type row, const size_type col) const
   { 
     assert(row < rowdim_);
     assert(col < coldim_);
-    return data_[row+col*rowdim_];
+    return data_[LAYOUT::index(row, col, ld_)];
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  C& Array2D<C>::operator () (const size_type row, const size_type col)
+  C& Array2D<C,LAYOUT>::operator () (const size_type row, const size_type col)
   {
     assert(row < rowdim_);
     assert(col < coldim_);
-    return data_[row+col*rowdim_];
+    return data_[LAYOUT::index(row, col, ld_)];
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  typename Array2D<C,LAYOUT>::const_iterator
+  Array2D<C,LAYOUT>::begin() const
+  {
+    return const_iterator(data_, rowdim_, ld_, 0);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  typename Array2D<C,LAYOUT>::iterator
+  Array2D<C,LAYOUT>::begin()
+  {
+    return iterator(data_, rowdim_, ld_, 0);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  typename Array2D<C,LAYOUT>::const_iterator
+  Array2D<C,LAYOUT>::end() const
+  {
+    return const_iterator(data_, rowdim_, ld_, size_);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  typename Array2D<C,LAYOUT>::iterator
+  Array2D<C,LAYOUT>::end()
+  {
+    return iterator(data_, rowdim_, ld_, size_);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  typename Array2D<C,LAYOUT>::const_pointer
+  Array2D<C,LAYOUT>::storage_begin() const
+  {
+    return data_;
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  typename Array2D<C>::const_iterator
-  Array2D<C>::begin() const
+  typename Array2D<C,LAYOUT>::pointer
+  Array2D<C,LAYOUT>::storage_begin()
   {
-    return &data_[0];
+    return data_;
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  typename Array2D<C>::iterator
-  Array2D<C>::begin()
+  typename Array2D<C,LAYOUT>::const_pointer
+  Array2D<C,LAYOUT>::storage_end() const
   {
-    return &data_[0];
+    return data_+storage_size();
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  typename Array2D<C>::const_iterator
-  Array2D<C>::end() const
+  typename Array2D<C,LAYOUT>::pointer
+  Array2D<C,LAYOUT>::storage_end()
   {
-    return &data_[size_];
+    return data_+storage_size();
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  typename Array2D<C>::iterator
-  Array2D<C>::end()
+  const C* Array2D<C,LAYOUT>::aligned_data() const
   {
-    return &data_[size_];
+    return std::assume_aligned<array_alignment<C>()>(data_);
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  void Array2D<C>::swap(Array2D<C>& a)
+  C* Array2D<C,LAYOUT>::aligned_data()
+  {
+    return std::assume_aligned<array_alignment<C>()>(data_);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array1DView<const C> Array2D<C,LAYOUT>::row(const size_type i) const
+    requires LAYOUT::strided
+  {
+    return Array2DView<const C>(*this).row(i);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array1DView<C> Array2D<C,LAYOUT>::row(const size_type i)
+    requires LAYOUT::strided
+  {
+    return Array2DView<C>(*this).row(i);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array1DView<const C> Array2D<C,LAYOUT>::column(const size_type j) const
+    requires LAYOUT::strided
+  {
+    return Array2DView<const C>(*this).column(j);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array1DView<C> Array2D<C,LAYOUT>::column(const size_type j)
+    requires LAYOUT::strided
+  {
+    return Array2DView<C>(*this).column(j);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2DView<const C> Array2D<C,LAYOUT>::block(const size_type row0, const size_type col0,
+                                                const size_type rows, const size_type columns) const
+    requires LAYOUT::strided
+  {
+    return Array2DView<const C>(*this).block(row0, col0, rows, columns);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  Array2DView<C> Array2D<C,LAYOUT>::block(const size_type row0, const size_type col0,
+                                          const size_type rows, const size_type columns)
+    requires LAYOUT::strided
+  {
+    return Array2DView<C>(*this).block(row0, col0, rows, columns);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  void Array2D<C,LAYOUT>::swap(Array2D<C,LAYOUT>& a) noexcept
   {
     std::swap(rowdim_, a.rowdim_);
     std::swap(coldim_, a.coldim_);
+    std::swap(size_, a.size_);
+    std::swap(ld_, a.ld_);
     std::swap(data_, a.data_);
+    std::swap(storage_, a.storage_);
+    std::swap(resource_, a.resource_);
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  const typename Array2D<C>::size_type
-  Array2D<C>::row_dimension() const
+  const typename Array2D<C,LAYOUT>::size_type
+  Array2D<C,LAYOUT>::row_dimension() const
   {
     return rowdim_;
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
   inline
-  const typename Array2D<C>::size_type
-  Array2D<C>::column_dimension() const
+  const typename Array2D<C,LAYOUT>::size_type
+  Array2D<C,LAYOUT>::column_dimension() const
   {
     return coldim_;
   }
 
-  template <class C>
+  template <class C, class LAYOUT>
+  inline
+  const typename Array2D<C,LAYOUT>::size_type
+  Array2D<C,LAYOUT>::leading_dimension() const
+  {
+    return ld_;
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  const typename Array2D<C,LAYOUT>::size_type
+  Array2D<C,LAYOUT>::storage_size() const
+  {
+    return LAYOUT::storage_size(rowdim_, coldim_, ld_);
+  }
+
+  template <class C, class LAYOUT>
+  inline
+  void swap(Array2D<C,LAYOUT>& a, Array2D<C,LAYOUT>& b) noexcept
+  {
+    a.swap(b);
+  }
+
+  // Copy the block [row0,row1) x [col0,col1) of a into b, optionally transposed,
+  // by recursively halving the longer side until the block fits into the L1 cache
+  // (cache-oblivious, so that neither the source nor the target layout
+  // needs to be known).
+  template <bool TRANSPOSE, class MATRIX1, class MATRIX2>
+  void blocked_copy(const MATRIX1& a, MATRIX2& b,
+                    const size_t row0, const size_t row1,
+                    const size_t col0, const size_t col1)
+  {
+    const size_t block_size(32);
+    if (row1-row0 > block_size && row1-row0 >= col1-col0)
+      {
+        const size_t rowm((row0+row1)/2);
+        blocked_copy<TRANSPOSE>(a, b, row0, rowm, col0, col1);
+        blocked_copy<TRANSPOSE>(a, b, rowm, row1, col0, col1);
+      }
+    else if (col1-col0 > block_size)
+      {
+        const size_t colm((col0+col1)/2);
+        blocked_copy<TRANSPOSE>(a, b, row0, row1, col0, colm);
+        blocked_copy<TRANSPOSE>(a, b, row0, row1, colm, col1);
+      }
+    else
+      for (size_t col(col0); col < col1; col++)
+        for (size_t row(row0); row < row1; row++)
+          if constexpr (TRANSPOSE)
+            b(col,row) = a(row,col);
+          else
+            b(row,col) = a(row,col);
+  }
+
+  template <class C, class LAYOUT1, class LAYOUT2>
+  void transpose(const Array2D<C,LAYOUT1>& a, Array2D<C,LAYOUT2>& b)
+  {
+    assert((const void*)&a != (const void*)&b);
+    b.resize(a.column_dimension(), a.row_dimension());
+    blocked_copy<true>(a, b, 0, a.row_dimension(), 0, a.column_dimension());
+  }
+
+  template <class C, class LAYOUT1, class LAYOUT2>
+  void convert_layout(const Array2D<C,LAYOUT1>& a, Array2D<C,LAYOUT2>& b)
+  {
+    assert((const void*)&a != (const void*)&b);
+    b.resize(a.row_dimension(), a.column_dimension());
+    blocked_copy<false>(a, b, 0, a.row_dimension(), 0, a.column_dimension());
+  }
+
+  template <class C, class LAYOUT>
   inline
-  std::ostream& operator << (std::ostream& os, const Array2D<C>& a)
+  std::ostream& operator << (std::ostream& os, const Array2D<C,LAYOUT>& a)
   {
     // use generic matrix print routine
     print_matrix(a, os);
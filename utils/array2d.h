@@ -12,15 +12,88 @@
 #ifndef _AMSTEL_ARRAY2D_H
 #define _AMSTEL_ARRAY2D_H
 
+#include <compare>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include "utils/aligned_memory.h"
+#include "utils/mapped_storage.h"
+#include "utils/array_layout.h"
+#include "utils/array_view.h"
 
 namespace AMSTeL
 {
+  /*!
+    random access iterator over the entries of an Array2D<C,LAYOUT>,
+    column by column and without the padding of the internal storage
+    (T is C or const C)
+  */
+  template <class T, class LAYOUT>
+  class Array2DIterator
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef std::remove_const_t<T> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    /*!
+      default constructor, yields a singular iterator
+    */
+    Array2DIterator();
+
+    /*!
+      iterator to the entry with (column-major) number index of the
+      array with the given storage, row dimension and leading dimension
+    */
+    Array2DIterator(T* data, const size_t rows, const size_t ld, const size_t index);
+
+    /*!
+      conversion to a read-only iterator
+    */
+    operator Array2DIterator<const T,LAYOUT> () const;
+
+    reference operator * () const;
+    pointer operator -> () const;
+    reference operator [] (const difference_type n) const;
+
+    Array2DIterator& operator ++ ();
+    Array2DIterator operator ++ (int);
+    Array2DIterator& operator -- ();
+    Array2DIterator operator -- (int);
+    Array2DIterator& operator += (const difference_type n);
+    Array2DIterator& operator -= (const difference_type n);
+    Array2DIterator operator + (const difference_type n) const;
+    Array2DIterator operator - (const difference_type n) const;
+    difference_type operator - (const Array2DIterator& it) const;
+
+    bool operator == (const Array2DIterator& it) const;
+    std::strong_ordering operator <=> (const Array2DIterator& it) const;
+
+  private:
+    T* data_;
+    size_t rows_, ld_, index_;
+  };
+
+  template <class T, class LAYOUT>
+  Array2DIterator<T,LAYOUT> operator + (const typename Array2DIterator<T,LAYOUT>::difference_type n,
+                                        const Array2DIterator<T,LAYOUT>& it);
+
   /*!
     This class models matrizes of objects from an arbitrary
     (scalar) class C and is merely a wrapper class around a conventional C-style array.
+    The storage layout is selected by the policy LAYOUT (cf. array_layout.h):
+    by default (ColumnMajor), the entries are stored column by column;
+    RowMajor and Tiled<B> are available for algorithms with other access patterns,
+    transpose() and convert_layout() move data between them.
+    The storage is aligned to array_alignment<C>() bytes, and the storage lines
+    (columns for ColumnMajor, rows for RowMajor) are padded to the
+    leading_dimension(), such that each line starts on an aligned boundary as well.
+    (The default LAYOUT=ColumnMajor is given in the forward declaration in array_view.h.)
   */
-  template <class C>
+  template <class C, class LAYOUT>
   class Array2D
   {
   public:
@@ -42,12 +115,12 @@ namespace AMSTeL
     /*!
       iterator type (cf. STL containers)
     */
-    typedef value_type* iterator;
+    typedef Array2DIterator<C,LAYOUT> iterator;
 
     /*!
       const iterator type (cf. STL containers)
     */
-    typedef const value_type* const_iterator;
+    typedef Array2DIterator<const C,LAYOUT> const_iterator;
 
     /*!
       reference type (cf. STL containers)
@@ -72,7 +145,12 @@ namespace AMSTeL
     /*!
       copy constructor
     */
-    Array2D(const Array2D<C>& a);
+    Array2D(const Array2D<C,LAYOUT>& a);
+
+    /*!
+      move constructor, takes over the storage of a and leaves a empty
+    */
+    Array2D(Array2D<C,LAYOUT>&& a) noexcept;
     
     /*!
       Construct an array of positive size s.
@@ -84,6 +162,33 @@ namespace AMSTeL
 
     Array2D(const size_type row,const size_type col);
 
+    /*!
+      Construct an array of size row x col, the entries are value-initialized
+      in parallel (first touch, cf. first_touch_t); the storage is split into
+      contiguous chunks, i.e., blocks of columns for the default layout.
+    */
+    Array2D(const size_type row, const size_type col, first_touch_t);
+
+    /*!
+      Construct an array of size row x col without initializing the entries,
+      if C is trivially default constructible (opt-in for performance-critical code).
+      This includes the padding entries, which the caller has to clear
+      (cf. LAYOUT::clear_padding()) before operations on the whole storage.
+    */
+    Array2D(const size_type row, const size_type col, no_initialization_t);
+
+    /*!
+      Construct an array of size row x col, backed by huge pages (cf. huge_pages_t).
+    */
+    Array2D(const size_type row, const size_type col, huge_pages_t);
+
+    /*!
+      Construct an array of size row x col, the storage of which is obtained
+      from the given memory resource; the array stays with the resource when
+      it is resized, the resource has to outlive the array.
+    */
+    Array2D(const size_type row, const size_type col, std::pmr::memory_resource* resource);
+
     /*!
       release allocated memory
     */
@@ -102,10 +207,21 @@ namespace AMSTeL
     */
     void resize(const size_type row,const size_type col);
 
+    /*!
+      Resize the array to the size row x col, all entries are value-initialized
+      in parallel (first touch, cf. first_touch_t).
+    */
+    void resize(const size_type row, const size_type col, first_touch_t);
+
     /*!
       assignment operator
     */
-    Array2D<C>& operator = (const Array2D<C>& a);
+    Array2D<C,LAYOUT>& operator = (const Array2D<C,LAYOUT>& a);
+
+    /*!
+      move assignment, takes over the storage of a and leaves a empty
+    */
+    Array2D<C,LAYOUT>& operator = (Array2D<C,LAYOUT>&& a) noexcept;
 
     /*!
       read-only access to the (row,col)-th array member
@@ -117,6 +233,13 @@ namespace AMSTeL
     */
     C& operator () (const size_type row, const size_type col);
 
+    /*!
+      Iterator access (cf. STL containers):
+      the iterators traverse the row_dimension() x column_dimension() entries
+      column by column, skipping the padding, i.e., end()-begin() == size().
+      Kernels working on the internal storage use storage_begin()/storage_end().
+    */
+
     /*!
       read-only iterator access to first element (cf. STL containers)
     */
@@ -140,10 +263,81 @@ namespace AMSTeL
     iterator end();
 
     /*!
-      swap components of two arrays
+      read-only access to the internal storage, in the order given by LAYOUT
+      and including the padding entries (if any), i.e.,
+      storage_end()-storage_begin() == storage_size()
+    */
+    const_pointer storage_begin() const;
+
+    /*!
+      read-write access to the internal storage (cf. storage_begin() const)
+    */
+    pointer storage_begin();
+
+    /*!
+      read-only pointer behind the internal storage
+    */
+    const_pointer storage_end() const;
+
+    /*!
+      read-write pointer behind the internal storage
+    */
+    pointer storage_end();
+
+    /*!
+      read-only access to the internal storage, the alignment of which
+      is made known to the compiler (cf. std::assume_aligned)
+    */
+    const C* aligned_data() const;
+
+    /*!
+      read-write access to the internal storage, the alignment of which
+      is made known to the compiler (cf. std::assume_aligned)
+    */
+    C* aligned_data();
+
+    /*!
+      read-only view of the i-th row (without copying)
+    */
+    Array1DView<const C> row(const size_type i) const requires LAYOUT::strided;
+
+    /*!
+      read-write view of the i-th row (without copying)
     */
-    void swap (Array2D<C>& a);
+    Array1DView<C> row(const size_type i) requires LAYOUT::strided;
 
+    /*!
+      read-only view of the j-th column (without copying)
+    */
+    Array1DView<const C> column(const size_type j) const requires LAYOUT::strided;
+
+    /*!
+      read-write view of the j-th column (without copying)
+    */
+    Array1DView<C> column(const size_type j) requires LAYOUT::strided;
+
+    /*!
+      read-only view of the rows x columns sub-block starting at (row0,col0)
+    */
+    Array2DView<const C> block(const size_type row0, const size_type col0,
+                               const size_type rows, const size_type columns) const
+      requires LAYOUT::strided;
+
+    /*!
+      read-write view of the rows x columns sub-block starting at (row0,col0)
+    */
+    Array2DView<C> block(const size_type row0, const size_type col0,
+                         const size_type rows, const size_type columns)
+      requires LAYOUT::strided;
+
+    /*!
+      swap components of two arrays (without any allocation)
+    */
+    void swap (Array2D<C,LAYOUT>& a) noexcept;
+
+    /*!
+      row dimension
+    */
     const size_type row_dimension() const;
 
     /*!
@@ -151,13 +345,51 @@ namespace AMSTeL
     */
     const size_type column_dimension() const;
 
-    
+    /*!
+      leading dimension, i.e., the padded length of a storage line
+      (the distance between two consecutive columns for ColumnMajor,
+      between two consecutive rows for RowMajor, the padded number of rows for Tiled<B>)
+    */
+    const size_type leading_dimension() const;
+
+    /*!
+      size of the internal storage, including the padding
+    */
+    const size_type storage_size() const;
+
+    /*!
+      origin of the internal storage (heap, huge pages or a mapped file)
+    */
+    storage_type storage() const;
+
+    /*!
+      memory resource providing the internal storage
+      (0 unless storage() == storage_type::memory_resource)
+    */
+    std::pmr::memory_resource* resource() const;
+
+    /*!
+      Replace the contents of the array by the row x col array stored in the
+      binary file filename, which is mapped into memory (entries are loaded on
+      demand by the operating system). The file holds the storage in the order
+      given by LAYOUT, without padding (cf. packed_leading_dimension());
+      for read_write, the file is created or extended if necessary.
+      Only for trivially copyable C. Returns false if the file cannot be mapped.
+      Assigning an array of the same size writes into the file. Resizing the
+      array to another size detaches it from the file, and as for all resize()
+      calls, the entries are not preserved. Copies of the array are stored
+      on the heap, with the usual padding.
+    */
+    bool map_file(const std::string& filename,
+                  const size_type row, const size_type col,
+                  const file_access access);
+
   protected:
     /*!
-      internal storage is just a pointer to a C array
+      internal storage is just a pointer to an aligned C array
     */
     C* data_;
-    
+
     /*!
       number of columns
     */
@@ -172,13 +404,73 @@ namespace AMSTeL
       size of the array
     */
     size_type size_;
+
+    /*!
+      leading dimension (padded length of a storage line)
+    */
+    size_type ld_;
+
+    /*!
+      origin of the internal storage
+    */
+    storage_type storage_;
+
+    /*!
+      memory resource for storage_type::memory_resource
+    */
+    std::pmr::memory_resource* resource_;
+
+  private:
+    /*!
+      initialization of newly allocated storage: default construction
+      with zero padding, value-initialization in parallel (cf. first_touch_t),
+      or none at all (cf. no_initialization_t)
+    */
+    enum class initialization { serial, first_touch, none };
+
+    /*!
+      (re)allocate the storage for row x col entries (releasing the old one)
+    */
+    void allocate(const size_type row, const size_type col,
+                  const initialization init = initialization::serial);
+
+    /*!
+      destroy all entries and release the storage
+    */
+    void deallocate();
+
+    /*!
+      copy the entries of an array of the same size, which may have a different
+      leading dimension (e.g., a file-backed array without padding)
+    */
+    void copy_entries(const Array2D<C,LAYOUT>& a);
   };
 
+  /*!
+    swap the contents of two arrays (without any allocation)
+  */
+  template <class C, class LAYOUT>
+  void swap(Array2D<C,LAYOUT>& a, Array2D<C,LAYOUT>& b) noexcept;
+
+  /*!
+    transposition b = a^T, b is resized appropriately;
+    a and b may have different layouts, the copy is cache-blocked
+  */
+  template <class C, class LAYOUT1, class LAYOUT2>
+  void transpose(const Array2D<C,LAYOUT1>& a, Array2D<C,LAYOUT2>& b);
+
+  /*!
+    copy a into b, which may have a different storage layout,
+    b is resized appropriately; the copy is cache-blocked
+  */
+  template <class C, class LAYOUT1, class LAYOUT2>
+  void convert_layout(const Array2D<C,LAYOUT1>& a, Array2D<C,LAYOUT2>& b);
+
   /*!
     Matlab-style stream output for arrays
    */
-  template <class C>
-  std::ostream& operator << (std::ostream& os, const Array2D<C>& a);
+  template <class C, class LAYOUT>
+  std::ostream& operator << (std::ostream& os, const Array2D<C,LAYOUT>& a);
 }
 
 // include implementation of inline functions
@@ -0,0 +1,138 @@
+// implementation for array_layout.h
+
+#include <algorithm>
+
+namespace AMSTeL
+{
+  template <class C>
+  inline
+  size_t ColumnMajor::leading_dimension(const size_t rows, const size_t /*columns*/)
+  {
+    return padded_length<C>(rows);
+  }
+
+  inline
+  size_t ColumnMajor::packed_leading_dimension(const size_t rows, const size_t /*columns*/)
+  {
+    return rows;
+  }
+
+  inline
+  size_t ColumnMajor::storage_size(const size_t /*rows*/, const size_t columns, const size_t ld)
+  {
+    return ld*columns;
+  }
+
+  inline
+  size_t ColumnMajor::index(const size_t row, const size_t col, const size_t ld)
+  {
+    return row+col*ld;
+  }
+
+  inline
+  size_t ColumnMajor::row_stride(const size_t /*ld*/)
+  {
+    return 1;
+  }
+
+  inline
+  size_t ColumnMajor::column_stride(const size_t ld)
+  {
+    return ld;
+  }
+
+  template <class C>
+  inline
+  void ColumnMajor::clear_padding(C* data, const size_t rows, const size_t columns, const size_t ld)
+  {
+    if (ld > rows)
+      for (size_t n(0); n < columns; n++)
+        std::fill(data+n*ld+rows, data+(n+1)*ld, C());
+  }
+
+  template <class C>
+  inline
+  size_t RowMajor::leading_dimension(const size_t /*rows*/, const size_t columns)
+  {
+    return padded_length<C>(columns);
+  }
+
+  inline
+  size_t RowMajor::packed_leading_dimension(const size_t /*rows*/, const size_t columns)
+  {
+    return columns;
+  }
+
+  inline
+  size_t RowMajor::storage_size(const size_t rows, const size_t /*columns*/, const size_t ld)
+  {
+    return ld*rows;
+  }
+
+  inline
+  size_t RowMajor::index(const size_t row, const size_t col, const size_t ld)
+  {
+    return row*ld+col;
+  }
+
+  inline
+  size_t RowMajor::row_stride(const size_t ld)
+  {
+    return ld;
+  }
+
+  inline
+  size_t RowMajor::column_stride(const size_t /*ld*/)
+  {
+    return 1;
+  }
+
+  template <class C>
+  inline
+  void RowMajor::clear_padding(C* data, const size_t rows, const size_t columns, const size_t ld)
+  {
+    if (ld > columns)
+      for (size_t m(0); m < rows; m++)
+        std::fill(data+m*ld+columns, data+(m+1)*ld, C());
+  }
+
+  template <unsigned int B>
+  template <class C>
+  inline
+  size_t Tiled<B>::leading_dimension(const size_t rows, const size_t /*columns*/)
+  {
+    return ((rows+B-1)/B)*B;
+  }
+
+  template <unsigned int B>
+  inline
+  size_t Tiled<B>::packed_leading_dimension(const size_t rows, const size_t /*columns*/)
+  {
+    return ((rows+B-1)/B)*B; // the tiles are always complete
+  }
+
+  template <unsigned int B>
+  inline
+  size_t Tiled<B>::storage_size(const size_t /*rows*/, const size_t columns, const size_t ld)
+  {
+    return ld*(((columns+B-1)/B)*B);
+  }
+
+  template <unsigned int B>
+  inline
+  size_t Tiled<B>::index(const size_t row, const size_t col, const size_t ld)
+  {
+    return (col/B)*ld*B + (row/B)*B*B + (col%B)*B + row%B;
+  }
+
+  template <unsigned int B>
+  template <class C>
+  inline
+  void Tiled<B>::clear_padding(C* data, const size_t rows, const size_t columns, const size_t ld)
+  {
+    const size_t padded_columns(((columns+B-1)/B)*B);
+    for (size_t n(0); n < padded_columns; n++)
+      for (size_t m(n < columns ? rows : 0); m < ld; m++)
+        data[index(m, n, ld)] = C();
+  }
+}
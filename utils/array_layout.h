@@ -0,0 +1,101 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_ARRAY_LAYOUT_H
+#define _AMSTEL_ARRAY_LAYOUT_H
+
+#include <cstddef>
+#include "utils/aligned_memory.h"
+
+namespace AMSTeL
+{
+  /*!
+    Storage layouts for Array2D<C,LAYOUT>.
+    A layout maps the index (row,col) of a rows x columns array onto an
+    offset in the internal storage. All layouts share the static interface
+
+      leading_dimension<C>(rows, columns):     padded length of a storage line
+      packed_leading_dimension(rows, columns): the same without alignment padding
+      storage_size(rows, columns, ld):         number of stored entries, including padding
+      index(row, col, ld):                     offset of the entry (row,col)
+      clear_padding(data, rows, columns, ld):  set all padding entries to C()
+
+    Strided layouts (strided == true) additionally provide the memory
+    distances row_stride(ld) and column_stride(ld), so that arrays with
+    such a layout can be accessed via Array1DView/Array2DView.
+  */
+
+  /*!
+    column-major storage (Fortran/Matlab style, the default):
+    the columns are stored one after another, each padded to ld entries
+  */
+  struct ColumnMajor
+  {
+    static constexpr bool strided = true;
+
+    template <class C>
+    static size_t leading_dimension(const size_t rows, const size_t columns);
+    static size_t packed_leading_dimension(const size_t rows, const size_t columns);
+    static size_t storage_size(const size_t rows, const size_t columns, const size_t ld);
+    static size_t index(const size_t row, const size_t col, const size_t ld);
+    static size_t row_stride(const size_t ld);
+    static size_t column_stride(const size_t ld);
+    template <class C>
+    static void clear_padding(C* data, const size_t rows, const size_t columns, const size_t ld);
+  };
+
+  /*!
+    row-major storage (C style):
+    the rows are stored one after another, each padded to ld entries
+  */
+  struct RowMajor
+  {
+    static constexpr bool strided = true;
+
+    template <class C>
+    static size_t leading_dimension(const size_t rows, const size_t columns);
+    static size_t packed_leading_dimension(const size_t rows, const size_t columns);
+    static size_t storage_size(const size_t rows, const size_t columns, const size_t ld);
+    static size_t index(const size_t row, const size_t col, const size_t ld);
+    static size_t row_stride(const size_t ld);
+    static size_t column_stride(const size_t ld);
+    template <class C>
+    static void clear_padding(C* data, const size_t rows, const size_t columns, const size_t ld);
+  };
+
+  /*!
+    tiled storage: the array is split into B x B tiles, which are stored
+    contiguously (column by column within a tile, and the tiles themselves
+    column by column). Both the rows and the columns of a tile share a few
+    cache lines, which benefits stencil-like access in both directions.
+    The row and column dimension are padded to multiples of B, so that
+    ld is the padded number of rows.
+  */
+  template <unsigned int B = 8>
+  struct Tiled
+  {
+    static_assert(B > 0, "tile size must be positive");
+
+    static constexpr bool strided = false;
+
+    template <class C>
+    static size_t leading_dimension(const size_t rows, const size_t columns);
+    static size_t packed_leading_dimension(const size_t rows, const size_t columns);
+    static size_t storage_size(const size_t rows, const size_t columns, const size_t ld);
+    static size_t index(const size_t row, const size_t col, const size_t ld);
+    template <class C>
+    static void clear_padding(C* data, const size_t rows, const size_t columns, const size_t ld);
+  };
+}
+
+#include "utils/array_layout.cpp"
+
+#endif
@@ -0,0 +1,177 @@
+// implementation of some (inline) Array1DView<C>:: and Array2DView<C>:: methods
+
+#include <cassert>
+#include "io/vector_io.h"
+#include "io/matrix_io.h"
+
+namespace AMSTeL
+{
+  template <class C>
+  constexpr
+  Array1DView<C>::Array1DView()
+    : data_(0), size_(0), stride_(1)
+  {
+  }
+
+  template <class C>
+  constexpr
+  Array1DView<C>::Array1DView(C* data, const size_type size, const size_type stride)
+    : data_(data), size_(size), stride_(stride)
+  {
+  }
+
+  template <class C>
+  template <class D>
+    requires std::is_same_v<const D, C>
+  constexpr
+  Array1DView<C>::Array1DView(const Array1DView<D>& v)
+    : data_(v.data()), size_(v.size()), stride_(v.stride())
+  {
+  }
+
+  template <class C>
+  constexpr
+  C& Array1DView<C>::operator [] (const size_type i) const
+  {
+    assert(i < size_);
+    return data_[i*stride_];
+  }
+
+  template <class C>
+  inline
+  Array2DView<C>::Array2DView()
+    : data_(0), rows_(0), columns_(0), row_stride_(1), column_stride_(0)
+  {
+  }
+
+  template <class C>
+  inline
+  Array2DView<C>::Array2DView(C* data, const size_type rows, const size_type columns,
+                              const size_type row_stride, const size_type column_stride)
+    : data_(data), rows_(rows), columns_(columns),
+      row_stride_(row_stride), column_stride_(column_stride)
+  {
+  }
+
+  template <class C>
+  template <class LAYOUT>
+    requires LAYOUT::strided
+  inline
+  Array2DView<C>::Array2DView(Array2D<value_type,LAYOUT>& a)
+    : data_(a.aligned_data()), rows_(a.row_dimension()), columns_(a.column_dimension()),
+      row_stride_(LAYOUT::row_stride(a.leading_dimension())),
+      column_stride_(LAYOUT::column_stride(a.leading_dimension()))
+  {
+  }
+
+  template <class C>
+  template <class LAYOUT>
+    requires (LAYOUT::strided && std::is_const_v<C>)
+  inline
+  Array2DView<C>::Array2DView(const Array2D<value_type,LAYOUT>& a)
+    : data_(a.aligned_data()), rows_(a.row_dimension()), columns_(a.column_dimension()),
+      row_stride_(LAYOUT::row_stride(a.leading_dimension())),
+      column_stride_(LAYOUT::column_stride(a.leading_dimension()))
+  {
+  }
+
+  template <class C>
+  template <class D>
+    requires std::is_same_v<const D, C>
+  inline
+  Array2DView<C>::Array2DView(const Array2DView<D>& v)
+    : data_(v.data()), rows_(v.row_dimension()), columns_(v.column_dimension()),
+      row_stride_(v.row_stride()), column_stride_(v.column_stride())
+  {
+  }
+
+#ifdef __cpp_lib_mdspan
+  template <class C>
+  inline
+  Array2DView<C>::Array2DView(const std::mdspan<C, std::dextents<size_type,2>, std::layout_stride>& m)
+    : data_(m.data_handle()), rows_(m.extent(0)), columns_(m.extent(1)),
+      row_stride_(m.stride(0)), column_stride_(m.stride(1))
+  {
+  }
+
+  template <class C>
+  inline
+  std::mdspan<C, std::dextents<typename Array2DView<C>::size_type,2>, std::layout_stride>
+  Array2DView<C>::to_mdspan() const
+  {
+    typedef std::dextents<size_type,2> extents_type;
+    return std::mdspan<C, extents_type, std::layout_stride>
+      (data_, std::layout_stride::mapping<extents_type>
+       (extents_type(rows_, columns_), std::array<size_type,2>{row_stride_, column_stride_}));
+  }
+#endif
+
+  template <class C>
+  inline
+  C& Array2DView<C>::operator () (const size_type row, const size_type col) const
+  {
+    assert(row < rows_);
+    assert(col < columns_);
+    return data_[row*row_stride_+col*column_stride_];
+  }
+
+  template <class C>
+  inline
+  Array1DView<C> Array2DView<C>::row(const size_type i) const
+  {
+    assert(i < rows_);
+    return Array1DView<C>(data_+i*row_stride_, columns_, column_stride_);
+  }
+
+  template <class C>
+  inline
+  Array1DView<C> Array2DView<C>::column(const size_type j) const
+  {
+    assert(j < columns_);
+    return Array1DView<C>(data_+j*column_stride_, rows_, row_stride_);
+  }
+
+  template <class C>
+  inline
+  Array2DView<C> Array2DView<C>::block(const size_type row0, const size_type col0,
+                                       const size_type rows, const size_type columns) const
+  {
+    assert(row0+rows <= rows_);
+    assert(col0+columns <= columns_);
+    return Array2DView<C>(data_+row0*row_stride_+col0*column_stride_,
+                          rows, columns, row_stride_, column_stride_);
+  }
+
+  template <class C>
+  inline
+  Array2DView<C> Array2DView<C>::interior() const
+  {
+    assert(rows_ >= 2 && columns_ >= 2);
+    return block(1, 1, rows_-2, columns_-2);
+  }
+
+  template <class C>
+  inline
+  Array2DView<C> Array2DView<C>::transposed() const
+  {
+    return Array2DView<C>(data_, columns_, rows_, column_stride_, row_stride_);
+  }
+
+  template <class C>
+  inline
+  std::ostream& operator << (std::ostream& os, const Array1DView<C>& v)
+  {
+    // use generic vector print routine
+    print_vector(v, os);
+    return os;
+  }
+
+  template <class C>
+  inline
+  std::ostream& operator << (std::ostream& os, const Array2DView<C>& v)
+  {
+    // use generic matrix print routine
+    print_matrix(v, os);
+    return os;
+  }
+}
@@ -0,0 +1,254 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_ARRAY_VIEW_H
+#define _AMSTEL_ARRAY_VIEW_H
+
+#include <iostream>
+#include <cstddef>
+#include <type_traits>
+#include <version>
+#include "utils/array_layout.h"
+#ifdef __cpp_lib_mdspan
+#include <array>
+#include <mdspan>
+#endif
+
+namespace AMSTeL
+{
+  // forward declaration of the owning array class (column-major by default)
+  template <class C, class LAYOUT = ColumnMajor> class Array2D;
+
+  /*!
+    Non-owning, strided view of a one-dimensional array, e.g., of a row
+    or a column of an Array2D. The view consists of a base pointer,
+    a size and a stride (in entries); C may be const-qualified for read-only views.
+    Array1DView<C> has the size()/operator[] interface of Array1D<C>,
+    so that it can be used with print_vector() and other generic routines.
+  */
+  template <class C>
+  class Array1DView
+  {
+  public:
+    /*!
+      value type (cf. STL containers)
+    */
+    typedef std::remove_const_t<C> value_type;
+
+    /*!
+      reference type (cf. STL containers)
+    */
+    typedef C& reference;
+
+    /*!
+      type of indexes and size of the view
+    */
+    typedef size_t size_type;
+
+    /*!
+      default constructor, yields an empty view
+    */
+    constexpr Array1DView();
+
+    /*!
+      view of the entries data[0], data[stride], ..., data[(size-1)*stride]
+    */
+    constexpr Array1DView(C* data, const size_type size, const size_type stride = 1);
+
+    /*!
+      read-only views from read-write views
+    */
+    template <class D>
+      requires std::is_same_v<const D, C>
+    constexpr Array1DView(const Array1DView<D>& v);
+
+    /*!
+      size of the view
+    */
+    constexpr size_type size() const { return size_; }
+
+    /*!
+      distance between two consecutive entries in memory
+    */
+    constexpr size_type stride() const { return stride_; }
+
+    /*!
+      pointer to the first entry
+    */
+    constexpr C* data() const { return data_; }
+
+    /*!
+      access to the i-th entry
+    */
+    constexpr C& operator [] (const size_type i) const;
+
+  protected:
+    C* data_;
+    size_type size_, stride_;
+  };
+
+  /*!
+    Non-owning, strided view of a two-dimensional array, e.g., of an Array2D
+    or a sub-block of it. The view consists of a base pointer, the extents
+    (row and column dimension) and the strides (distance between two
+    consecutive entries of a column and of a row, respectively);
+    C may be const-qualified for read-only views.
+    Array2DView<C> has the row_dimension()/column_dimension()/operator()
+    interface of Array2D<C>, so that it can be used with print_matrix()
+    and the generic MATRIX routines of the library. Views of views
+    (rows, columns, blocks) never allocate.
+  */
+  template <class C>
+  class Array2DView
+  {
+  public:
+    /*!
+      value type (cf. STL containers)
+    */
+    typedef std::remove_const_t<C> value_type;
+
+    /*!
+      reference type (cf. STL containers)
+    */
+    typedef C& reference;
+
+    /*!
+      type of indexes and size of the view
+    */
+    typedef size_t size_type;
+
+    /*!
+      default constructor, yields an empty view
+    */
+    Array2DView();
+
+    /*!
+      view of the entries data[row*row_stride+col*column_stride]
+    */
+    Array2DView(C* data, const size_type rows, const size_type columns,
+                const size_type row_stride, const size_type column_stride);
+
+    /*!
+      view of a whole Array2D with a strided layout
+    */
+    template <class LAYOUT>
+      requires LAYOUT::strided
+    Array2DView(Array2D<value_type,LAYOUT>& a);
+
+    /*!
+      read-only view of a whole Array2D with a strided layout
+    */
+    template <class LAYOUT>
+      requires (LAYOUT::strided && std::is_const_v<C>)
+    Array2DView(const Array2D<value_type,LAYOUT>& a);
+
+    /*!
+      read-only views from read-write views
+    */
+    template <class D>
+      requires std::is_same_v<const D, C>
+    Array2DView(const Array2DView<D>& v);
+
+#ifdef __cpp_lib_mdspan
+    /*!
+      view of a two-dimensional std::mdspan with arbitrary strides
+    */
+    Array2DView(const std::mdspan<C, std::dextents<size_type,2>, std::layout_stride>& m);
+
+    /*!
+      conversion into a std::mdspan
+    */
+    std::mdspan<C, std::dextents<size_type,2>, std::layout_stride> to_mdspan() const;
+#endif
+
+    /*!
+      row dimension
+    */
+    inline size_type row_dimension() const { return rows_; }
+
+    /*!
+      column dimension
+    */
+    inline size_type column_dimension() const { return columns_; }
+
+    /*!
+      number of entries
+    */
+    inline size_type size() const { return rows_*columns_; }
+
+    /*!
+      distance between the entries (row,col) and (row+1,col) in memory
+    */
+    inline size_type row_stride() const { return row_stride_; }
+
+    /*!
+      distance between the entries (row,col) and (row,col+1) in memory
+    */
+    inline size_type column_stride() const { return column_stride_; }
+
+    /*!
+      pointer to the entry (0,0)
+    */
+    inline C* data() const { return data_; }
+
+    /*!
+      access to the (row,col)-th entry
+    */
+    C& operator () (const size_type row, const size_type col) const;
+
+    /*!
+      view of the i-th row
+    */
+    Array1DView<C> row(const size_type i) const;
+
+    /*!
+      view of the j-th column
+    */
+    Array1DView<C> column(const size_type j) const;
+
+    /*!
+      view of the rows x columns sub-block starting at (row0,col0)
+    */
+    Array2DView<C> block(const size_type row0, const size_type col0,
+                         const size_type rows, const size_type columns) const;
+
+    /*!
+      view of the interior, i.e., without the first and last row and column
+    */
+    Array2DView<C> interior() const;
+
+    /*!
+      view of the transposed array
+    */
+    Array2DView<C> transposed() const;
+
+  protected:
+    C* data_;
+    size_type rows_, columns_, row_stride_, column_stride_;
+  };
+
+  /*!
+    Matlab-style stream output for views
+  */
+  template <class C>
+  std::ostream& operator << (std::ostream& os, const Array1DView<C>& v);
+
+  /*!
+    Matlab-style stream output for views
+  */
+  template <class C>
+  std::ostream& operator << (std::ostream& os, const Array2DView<C>& v);
+}
+
+// include implementation of inline functions
+#include "utils/array_view.cpp"
+
+#endif
@@ -0,0 +1,112 @@
+// implementation of some (constexpr) FixedArray1D<C,N>:: methods
+
+#include <cassert>
+#include <utility>
+#include "io/vector_io.h"
+
+namespace AMSTeL
+{
+  template <class C, unsigned int N>
+  constexpr
+  FixedArray1D<C,N>::FixedArray1D()
+    : data_{}
+  {
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  FixedArray1D<C,N>::FixedArray1D(std::initializer_list<C> values)
+    : data_{}
+  {
+    assert(values.size() <= N);
+    size_type i(0);
+    for (const C& value : values)
+      data_[i++] = value;
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  void FixedArray1D<C,N>::resize(const size_type)
+  {
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  const C& FixedArray1D<C,N>::operator [] (const size_type i) const
+  {
+    assert(i < N);
+    return data_[i];
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  C& FixedArray1D<C,N>::operator [] (const size_type i)
+  {
+    assert(i < N);
+    return data_[i];
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  typename FixedArray1D<C,N>::const_iterator
+  FixedArray1D<C,N>::begin() const
+  {
+    return data_;
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  typename FixedArray1D<C,N>::iterator
+  FixedArray1D<C,N>::begin()
+  {
+    return data_;
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  typename FixedArray1D<C,N>::const_iterator
+  FixedArray1D<C,N>::end() const
+  {
+    return data_+N;
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  typename FixedArray1D<C,N>::iterator
+  FixedArray1D<C,N>::end()
+  {
+    return data_+N;
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  void FixedArray1D<C,N>::swap(FixedArray1D<C,N>& a)
+  {
+    for (size_type i(0); i < N; i++)
+      std::swap(data_[i], a.data_[i]);
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  void FixedArray1D<C,N>::swap(const size_type i, const size_type j)
+  {
+    assert(i < N && j < N);
+    std::swap(data_[i], data_[j]);
+  }
+
+  template <class C, unsigned int N>
+  constexpr
+  void swap(FixedArray1D<C,N>& a, FixedArray1D<C,N>& b)
+  {
+    a.swap(b);
+  }
+
+  template <class C, unsigned int N>
+  inline
+  std::ostream& operator << (std::ostream& os, const FixedArray1D<C,N>& a)
+  {
+    // use generic vector print routine
+    print_vector(a, os);
+    return os;
+  }
+}
@@ -0,0 +1,161 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_FIXED_ARRAY1D_H
+#define _AMSTEL_FIXED_ARRAY1D_H
+
+#include <iostream>
+#include <cstddef>
+#include <initializer_list>
+
+namespace AMSTeL
+{
+  /*!
+    This class models arrays of N objects from an arbitrary class C,
+    where N is known at compile time, e.g., refinement masks or quadrature rules.
+    The entries are stored within the object (no heap allocation), all
+    methods are constexpr, and loops over size() have a constant trip count.
+    FixedArray1D<C,N> has the interface of Array1D<C> (except for the
+    methods changing the size), so that generic code can be written for both.
+  */
+  template <class C, unsigned int N>
+  class FixedArray1D
+  {
+  public:
+    /*!
+      value type (cf. STL containers)
+     */
+    typedef C value_type;
+
+    /*!
+      pointer type (cf. STL containers)
+     */
+    typedef value_type* pointer;
+
+    /*!
+      const pointer type (cf. STL containers)
+    */
+    typedef const value_type* const_pointer;
+
+    /*!
+      iterator type (cf. STL containers)
+    */
+    typedef value_type* iterator;
+
+    /*!
+      const iterator type (cf. STL containers)
+    */
+    typedef const value_type* const_iterator;
+
+    /*!
+      reference type (cf. STL containers)
+    */
+    typedef value_type& reference;
+    
+    /*!
+      const reference type (cf. STL containers)
+    */
+    typedef const value_type& const_reference;
+
+    /*!
+      type of indexes and size of the array
+     */
+    typedef size_t size_type;
+
+    /*!
+      default constructor, all entries are value-initialized (i.e., zero for scalars)
+     */
+    constexpr FixedArray1D();
+
+    /*!
+      construct an array from a list of at most N values,
+      the remaining entries are value-initialized,
+      e.g., FixedArray1D<double,3> mask{0.5, 1.0, 0.5}
+    */
+    constexpr FixedArray1D(std::initializer_list<C> values);
+
+    /*!
+      size of the array
+    */
+    constexpr size_type size() const { return N; }
+
+    /*!
+      The size cannot change, resize() does nothing. It is provided for
+      generic code like read_vector(), which has to check size() afterwards.
+    */
+    constexpr void resize(const size_type s);
+
+    /*!
+      read-only access to the i-th array member
+    */
+    constexpr const C& operator [] (const size_type i) const;
+
+    /*!
+      read-write access to the i-th array member
+    */
+    constexpr C& operator [] (const size_type i);
+
+    /*!
+      read-only iterator access to first element (cf. STL containers)
+    */
+    constexpr const_iterator begin() const;
+
+    /*!
+      read-write iterator access to first element (cf. STL containers)
+    */
+    constexpr iterator begin();
+
+    /*!
+      read-only iterator access to the element behind the last one
+      (cf. STL containers)
+    */
+    constexpr const_iterator end() const;
+
+    /*!
+      read-write iterator access to the element behind the last one
+      (cf. STL containers)
+    */
+    constexpr iterator end();
+
+    /*!
+      swap the contents of two arrays
+    */
+    constexpr void swap (FixedArray1D<C,N>& a);
+
+    /*!
+      swap two entries
+    */
+    constexpr void swap (const size_type i, const size_type j);
+
+  protected:
+    /*!
+      internal storage (at least one entry, to avoid zero-length arrays)
+    */
+    C data_[N > 0 ? N : 1];
+  };
+
+  /*!
+    swap the contents of two arrays
+  */
+  template <class C, unsigned int N>
+  constexpr void swap(FixedArray1D<C,N>& a, FixedArray1D<C,N>& b);
+
+  /*!
+    Matlab-style stream output for arrays
+   */
+  template <class C, unsigned int N>
+  std::ostream& operator << (std::ostream& os, const FixedArray1D<C,N>& a);
+}
+
+// include implementation of inline functions
+#include "utils/fixed_array1d.cpp"
+
+#endif
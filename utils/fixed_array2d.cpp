@@ -0,0 +1,144 @@
+// implementation of some (constexpr) FixedArray2D<C,R,K>:: methods
+
+#include <cassert>
+#include <utility>
+#include "io/matrix_io.h"
+
+namespace AMSTeL
+{
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  FixedArray2D<C,R,K>::FixedArray2D()
+    : data_{}
+  {
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  FixedArray2D<C,R,K>::FixedArray2D(std::initializer_list<std::initializer_list<C> > rows)
+    : data_{}
+  {
+    assert(rows.size() <= R);
+    size_type row(0);
+    for (const std::initializer_list<C>& values : rows)
+      {
+        assert(values.size() <= K);
+        size_type col(0);
+        for (const C& value : values)
+          data_[row+R*col++] = value;
+        row++;
+      }
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  void FixedArray2D<C,R,K>::resize(const size_type, const size_type)
+  {
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  const C& FixedArray2D<C,R,K>::operator () (const size_type row, const size_type col) const
+  {
+    assert(row < R);
+    assert(col < K);
+    return data_[row+R*col];
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  C& FixedArray2D<C,R,K>::operator () (const size_type row, const size_type col)
+  {
+    assert(row < R);
+    assert(col < K);
+    return data_[row+R*col];
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  typename FixedArray2D<C,R,K>::const_iterator
+  FixedArray2D<C,R,K>::begin() const
+  {
+    return data_;
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  typename FixedArray2D<C,R,K>::iterator
+  FixedArray2D<C,R,K>::begin()
+  {
+    return data_;
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  typename FixedArray2D<C,R,K>::const_iterator
+  FixedArray2D<C,R,K>::end() const
+  {
+    return data_+R*K;
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  typename FixedArray2D<C,R,K>::iterator
+  FixedArray2D<C,R,K>::end()
+  {
+    return data_+R*K;
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  Array1DView<const C> FixedArray2D<C,R,K>::row(const size_type i) const
+  {
+    assert(i < R);
+    return Array1DView<const C>(data_+i, K, R);
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  Array1DView<C> FixedArray2D<C,R,K>::row(const size_type i)
+  {
+    assert(i < R);
+    return Array1DView<C>(data_+i, K, R);
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  Array1DView<const C> FixedArray2D<C,R,K>::column(const size_type j) const
+  {
+    assert(j < K);
+    return Array1DView<const C>(data_+R*j, R);
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  Array1DView<C> FixedArray2D<C,R,K>::column(const size_type j)
+  {
+    assert(j < K);
+    return Array1DView<C>(data_+R*j, R);
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  void FixedArray2D<C,R,K>::swap(FixedArray2D<C,R,K>& a)
+  {
+    for (size_type i(0); i < R*K; i++)
+      std::swap(data_[i], a.data_[i]);
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  constexpr
+  void swap(FixedArray2D<C,R,K>& a, FixedArray2D<C,R,K>& b)
+  {
+    a.swap(b);
+  }
+
+  template <class C, unsigned int R, unsigned int K>
+  inline
+  std::ostream& operator << (std::ostream& os, const FixedArray2D<C,R,K>& a)
+  {
+    // use generic matrix print routine
+    print_matrix(a, os);
+    return os;
+  }
+}
@@ -0,0 +1,195 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_FIXED_ARRAY2D_H
+#define _AMSTEL_FIXED_ARRAY2D_H
+
+#include <iostream>
+#include <cstddef>
+#include <initializer_list>
+#include "utils/array_view.h"
+
+namespace AMSTeL
+{
+  /*!
+    This class models R x K matrizes of objects from an arbitrary class C,
+    where R and K are known at compile time, e.g., local element matrices
+    or small stencils. The entries are stored column by column within the
+    object (no heap allocation, no padding), all methods are constexpr,
+    and loops over the dimensions have constant trip counts.
+    FixedArray2D<C,R,K> has the interface of Array2D<C> (except for the
+    methods changing the size), so that generic code can be written for both.
+  */
+  template <class C, unsigned int R, unsigned int K>
+  class FixedArray2D
+  {
+  public:
+    /*!
+      value type (cf. STL containers)
+     */
+    typedef C value_type;
+
+    /*!
+      pointer type (cf. STL containers)
+     */
+    typedef value_type* pointer;
+
+    /*!
+      const pointer type (cf. STL containers)
+    */
+    typedef const value_type* const_pointer;
+
+    /*!
+      iterator type (cf. STL containers)
+    */
+    typedef value_type* iterator;
+
+    /*!
+      const iterator type (cf. STL containers)
+    */
+    typedef const value_type* const_iterator;
+
+    /*!
+      reference type (cf. STL containers)
+    */
+    typedef value_type& reference;
+    
+    /*!
+      const reference type (cf. STL containers)
+    */
+    typedef const value_type& const_reference;
+
+    /*!
+      type of indexes and size of the array
+     */
+    typedef size_t size_type;
+
+    /*!
+      default constructor, all entries are value-initialized (i.e., zero for scalars)
+     */
+    constexpr FixedArray2D();
+
+    /*!
+      construct an array from a list of at most R rows with at most K entries each,
+      the remaining entries are value-initialized,
+      e.g., FixedArray2D<double,2,2> A{{1, 2}, {3, 4}}
+    */
+    constexpr FixedArray2D(std::initializer_list<std::initializer_list<C> > rows);
+
+    /*!
+      size of the array
+    */
+    constexpr size_type size() const { return R*K; }
+
+    /*!
+      row dimension
+    */
+    constexpr size_type row_dimension() const { return R; }
+
+    /*!
+      column dimension
+    */
+    constexpr size_type column_dimension() const { return K; }
+
+    /*!
+      leading dimension, i.e., the distance between two consecutive
+      columns in the internal storage
+    */
+    constexpr size_type leading_dimension() const { return R; }
+
+    /*!
+      The dimensions cannot change, resize() does nothing. It is provided for
+      generic code like read_matrix(), which has to check the dimensions afterwards.
+    */
+    constexpr void resize(const size_type row, const size_type col);
+
+    /*!
+      read-only access to the (row,col)-th array member
+    */
+    constexpr const C& operator () (const size_type row, const size_type col) const;
+
+    /*!
+      read-write access to the (row,col)-th member
+    */
+    constexpr C& operator () (const size_type row, const size_type col);
+
+    /*!
+      read-only iterator access to first element (cf. STL containers),
+      the iterators traverse the entries column by column
+    */
+    constexpr const_iterator begin() const;
+
+    /*!
+      read-write iterator access to first element (cf. STL containers)
+    */
+    constexpr iterator begin();
+
+    /*!
+      read-only iterator access to the element behind the last one
+      (cf. STL containers)
+    */
+    constexpr const_iterator end() const;
+
+    /*!
+      read-write iterator access to the element behind the last one
+      (cf. STL containers)
+    */
+    constexpr iterator end();
+
+    /*!
+      read-only view of the i-th row (without copying)
+    */
+    constexpr Array1DView<const C> row(const size_type i) const;
+
+    /*!
+      read-write view of the i-th row (without copying)
+    */
+    constexpr Array1DView<C> row(const size_type i);
+
+    /*!
+      read-only view of the j-th column (without copying)
+    */
+    constexpr Array1DView<const C> column(const size_type j) const;
+
+    /*!
+      read-write view of the j-th column (without copying)
+    */
+    constexpr Array1DView<C> column(const size_type j);
+
+    /*!
+      swap the contents of two arrays
+    */
+    constexpr void swap (FixedArray2D<C,R,K>& a);
+
+  protected:
+    /*!
+      internal storage (at least one entry, to avoid zero-length arrays)
+    */
+    C data_[R*K > 0 ? R*K : 1];
+  };
+
+  /*!
+    swap the contents of two arrays
+  */
+  template <class C, unsigned int R, unsigned int K>
+  constexpr void swap(FixedArray2D<C,R,K>& a, FixedArray2D<C,R,K>& b);
+
+  /*!
+    Matlab-style stream output for arrays
+   */
+  template <class C, unsigned int R, unsigned int K>
+  std::ostream& operator << (std::ostream& os, const FixedArray2D<C,R,K>& a);
+}
+
+// include implementation of inline functions
+#include "utils/fixed_array2d.cpp"
+
+#endif
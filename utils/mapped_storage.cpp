@@ -0,0 +1,129 @@
+// implementation for mapped_storage.h
+
+#include <new>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace AMSTeL
+{
+  // huge page size on x86-64 and most ARM configurations
+  inline constexpr size_t amstel_huge_page_size(size_t(2) << 20);
+
+  // length of a huge page mapping for n objects of type C
+  template <class C>
+  inline
+  size_t huge_page_length(const size_t n)
+  {
+    return ((n*sizeof(C) + amstel_huge_page_size - 1) / amstel_huge_page_size) * amstel_huge_page_size;
+  }
+
+  inline
+  storage_type reallocation_type(const storage_type type)
+  {
+    return (type == storage_type::huge_pages || type == storage_type::memory_resource
+            ? type : storage_type::aligned_heap);
+  }
+
+  template <class C>
+  C* allocate_storage(const size_t n, const storage_type type,
+                      std::pmr::memory_resource* resource)
+  {
+    if (n == 0)
+      return 0;
+    if (type == storage_type::memory_resource)
+      return static_cast<C*>(resource->allocate(n*sizeof(C), array_alignment<C>()));
+    if (reallocation_type(type) == storage_type::aligned_heap)
+      return allocate_aligned<C>(n);
+
+    const size_t length(huge_page_length<C>(n));
+    void* p(MAP_FAILED);
+#ifdef MAP_HUGETLB
+    p = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (p == MAP_FAILED)
+      {
+        // no explicit huge pages reserved, ask for transparent ones
+        p = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+          throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+        madvise(p, length, MADV_HUGEPAGE);
+#endif
+      }
+    return static_cast<C*>(p);
+  }
+
+  template <class C>
+  bool map_file_storage(const std::string& filename, const file_access access,
+                        size_t& n, C*& p)
+  {
+    static_assert(std::is_trivially_copyable_v<C>,
+                  "only arrays of trivially copyable types can be backed by files");
+
+    const bool shared(access == file_access::read_write);
+    const int fd(shared
+                 ? ::open(filename.c_str(), O_RDWR | O_CREAT, 0644)
+                 : ::open(filename.c_str(), O_RDONLY));
+    if (fd < 0)
+      return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+      {
+        ::close(fd);
+        return false;
+      }
+
+    const size_t entries(info.st_size / sizeof(C));
+    if (n == size_t(-1))
+      n = entries;
+    else if (n > entries
+             && (!shared || ftruncate(fd, n*sizeof(C)) != 0))
+      {
+        ::close(fd);
+        return false;
+      }
+
+    p = 0;
+    if (n > 0)
+      {
+        void* q(mmap(0, n*sizeof(C), PROT_READ | PROT_WRITE,
+                     shared ? MAP_SHARED : MAP_PRIVATE, fd, 0));
+        if (q == MAP_FAILED)
+          {
+            ::close(fd);
+            return false;
+          }
+        p = static_cast<C*>(q);
+      }
+    ::close(fd); // the mapping stays valid
+
+    return true;
+  }
+
+  template <class C>
+  void release_storage(C* p, const size_t n, const storage_type type,
+                       std::pmr::memory_resource* resource)
+  {
+    if (p == 0)
+      return;
+    switch (type)
+      {
+      case storage_type::aligned_heap:
+        deallocate_aligned(p);
+        break;
+      case storage_type::huge_pages:
+        munmap(static_cast<void*>(p), huge_page_length<C>(n));
+        break;
+      case storage_type::memory_resource:
+        resource->deallocate(static_cast<void*>(p), n*sizeof(C), array_alignment<C>());
+        break;
+      default:
+        munmap(static_cast<void*>(p), n*sizeof(C));
+        break;
+      }
+  }
+}
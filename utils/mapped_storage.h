@@ -0,0 +1,96 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_MAPPED_STORAGE_H
+#define _AMSTEL_MAPPED_STORAGE_H
+
+#include <cstddef>
+#include <string>
+#include <memory_resource>
+#include "utils/aligned_memory.h"
+
+namespace AMSTeL
+{
+  /*!
+    origin of the storage of an Array1D or Array2D:
+    aligned heap memory (the default), anonymous memory backed by huge pages,
+    a memory-mapped file (private copy-on-write or shared mapping),
+    or a user-supplied std::pmr::memory_resource (e.g., a SlabPoolResource)
+  */
+  enum class storage_type : unsigned char
+    {
+      aligned_heap,
+      huge_pages,
+      private_file,
+      shared_file,
+      memory_resource
+    };
+
+  /*!
+    access mode for file-backed arrays:
+    read_only maps the file privately, i.e., the file is never modified,
+    and writes to the array only go to private copy-on-write pages;
+    read_write maps the file shared, i.e., writes to the array go to the file
+    (the file is created or extended if necessary)
+  */
+  enum class file_access
+    {
+      read_only,
+      read_write
+    };
+
+  /*!
+    tag type for array constructors, requesting storage backed by huge pages:
+    explicit huge pages (MAP_HUGETLB) if the system has reserved some,
+    transparent huge pages (MADV_HUGEPAGE) otherwise;
+    the storage of the array stays on huge pages when it is reallocated
+  */
+  struct huge_pages_t {};
+  inline constexpr huge_pages_t huge_pages{};
+
+  /*!
+    storage type used when an array with the given storage has to be reallocated:
+    huge pages and memory resources are kept, arrays detach from their files
+    to heap memory
+  */
+  storage_type reallocation_type(const storage_type type);
+
+  /*!
+    allocate uninitialized storage for n objects of type C
+    (aligned_heap, huge_pages or memory_resource from the given resource,
+    n=0 yields a null pointer); throws std::bad_alloc on failure
+  */
+  template <class C>
+  C* allocate_storage(const size_t n, const storage_type type,
+                      std::pmr::memory_resource* resource = 0);
+
+  /*!
+    map n objects of type C from the given file into memory, where n=size_t(-1)
+    maps the whole file and sets n to the number of entries in the file;
+    the file holds the objects in binary form, starting at offset 0.
+    Returns false if the file cannot be mapped or (for read_only) is too short.
+  */
+  template <class C>
+  bool map_file_storage(const std::string& filename, const file_access access,
+                        size_t& n, C*& p);
+
+  /*!
+    release storage for n objects obtained from allocate_storage() or
+    map_file_storage() (the objects have to be destroyed before)
+  */
+  template <class C>
+  void release_storage(C* p, const size_t n, const storage_type type,
+                       std::pmr::memory_resource* resource = 0);
+}
+
+#include "utils/mapped_storage.cpp"
+
+#endif
@@ -0,0 +1,119 @@
+// implementation for parallel_for.h
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace AMSTeL
+{
+  // global thread count, 0 means "use the hardware concurrency"
+  inline unsigned int amstel_number_of_threads(0);
+
+  inline
+  unsigned int number_of_threads()
+  {
+    if (amstel_number_of_threads > 0)
+      return amstel_number_of_threads;
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  inline
+  void set_number_of_threads(const unsigned int n)
+  {
+    amstel_number_of_threads = n;
+  }
+
+  inline
+  void chunk_bounds(const size_t begin, const size_t end,
+                    const unsigned int chunk, const unsigned int chunks,
+                    size_t& chunk_begin, size_t& chunk_end)
+  {
+    const size_t length(end-begin), q(length/chunks), r(length%chunks);
+    // the first r chunks get one index more than the others
+    chunk_begin = begin + chunk*q + std::min<size_t>(chunk, r);
+    chunk_end = chunk_begin + q + (chunk < r ? 1 : 0);
+  }
+
+  inline
+  unsigned int parallel_chunks(const size_t begin, const size_t end,
+                               const size_t grain)
+  {
+    if (end <= begin)
+      return 1;
+    const size_t max_chunks((end-begin) / std::max<size_t>(grain, 1));
+    return (unsigned int) std::max<size_t>(1, std::min<size_t>(number_of_threads(), max_chunks));
+  }
+
+  template <class FUNCTION>
+  void parallel_for(const size_t begin, const size_t end,
+                    FUNCTION f, const size_t grain)
+  {
+    if (end <= begin)
+      return;
+
+    const unsigned int chunks(parallel_chunks(begin, end, grain));
+    if (chunks == 1)
+      {
+        f(begin, end, 0u);
+        return;
+      }
+
+    // exceptions must not leave the worker threads (std::terminate()),
+    // they are collected per chunk and rethrown after all threads are joined
+    std::vector<std::exception_ptr> errors(chunks);
+    auto run = [f, &errors](const size_t chunk_begin, const size_t chunk_end,
+                            const unsigned int chunk) mutable
+      {
+        try
+          {
+            f(chunk_begin, chunk_end, chunk);
+          }
+        catch (...)
+          {
+            errors[chunk] = std::current_exception();
+          }
+      };
+
+    std::vector<std::thread> threads;
+    std::exception_ptr error;
+    try
+      {
+        threads.reserve(chunks-1);
+        size_t chunk_begin, chunk_end;
+        for (unsigned int chunk(1); chunk < chunks; chunk++)
+          {
+            chunk_bounds(begin, end, chunk, chunks, chunk_begin, chunk_end);
+            threads.emplace_back(run, chunk_begin, chunk_end, chunk);
+          }
+        chunk_bounds(begin, end, 0, chunks, chunk_begin, chunk_end);
+        run(chunk_begin, chunk_end, 0u);
+      }
+    catch (...)
+      {
+        // a thread could not be started, the remaining chunks are not processed
+        error = std::current_exception();
+      }
+
+    for (unsigned int t(0); t < threads.size(); t++)
+      threads[t].join();
+
+    for (unsigned int chunk(0); chunk < chunks && !error; chunk++)
+      error = errors[chunk];
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  template <class FUNCTION>
+  inline
+  void parallel_loop(const size_t begin, const size_t end,
+                     FUNCTION f, const size_t grain)
+  {
+    parallel_for(begin, end,
+                 [&f](const size_t chunk_begin, const size_t chunk_end, const unsigned int)
+                 {
+                   for (size_t i(chunk_begin); i < chunk_end; i++)
+                     f(i);
+                 }, grain);
+  }
+}
@@ -0,0 +1,76 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_PARALLEL_FOR_H
+#define _AMSTEL_PARALLEL_FOR_H
+
+#include <cstddef>
+
+namespace AMSTeL
+{
+  /*!
+    number of threads used by the parallel algorithms of the library
+    (default: std::thread::hardware_concurrency())
+  */
+  unsigned int number_of_threads();
+
+  /*!
+    set the number of threads used by the parallel algorithms of the library
+    (n=0 restores the default)
+  */
+  void set_number_of_threads(const unsigned int n);
+
+  /*!
+    Static partition of the index range [begin,end) into chunks:
+    computes the bounds [chunk_begin,chunk_end) of the chunk with number
+    chunk out of chunks contiguous chunks of (almost) equal size.
+    The worker threads are started anew by each parallel_for() and are not
+    pinned to processors; with different grains, the partitions of
+    two loops over the same range differ as well.
+  */
+  void chunk_bounds(const size_t begin, const size_t end,
+                    const unsigned int chunk, const unsigned int chunks,
+                    size_t& chunk_begin, size_t& chunk_end);
+
+  /*!
+    number of chunks parallel_for() will use for the index range [begin,end),
+    such that each chunk has at least grain indices
+  */
+  unsigned int parallel_chunks(const size_t begin, const size_t end,
+                               const size_t grain = 1);
+
+  /*!
+    Generic parallel loop over the index range [begin,end):
+    the range is split into parallel_chunks(begin,end,grain) contiguous chunks,
+    and f(chunk_begin, chunk_end, chunk) is called for each chunk on its own thread.
+    The calling thread processes the first chunk. Ranges with less than 2*grain
+    indices are processed serially.
+    If f throws (or a thread cannot be started), all started threads are joined,
+    and the exception of the first failed chunk is rethrown on the calling thread.
+  */
+  template <class FUNCTION>
+  void parallel_for(const size_t begin, const size_t end,
+                    FUNCTION f, const size_t grain = 1);
+
+  /*!
+    Parallel loop over the index range [begin,end), calling f(i) for each index
+    (with the same partition as parallel_for()). Each chunk is processed by a
+    plain counted loop with the inlined body f, which the compiler can vectorize,
+    e.g., for pointwise operations on contiguous arrays.
+  */
+  template <class FUNCTION>
+  void parallel_loop(const size_t begin, const size_t end,
+                     FUNCTION f, const size_t grain = 1);
+}
+
+#include "utils/parallel_for.cpp"
+
+#endif
@@ -0,0 +1,95 @@
+// implementation for slab_pool.h
+
+#include <algorithm>
+
+namespace AMSTeL
+{
+  inline
+  SlabPoolResource::SlabPoolResource(std::pmr::memory_resource* upstream,
+                                     const size_t max_block,
+                                     const size_t slab_size)
+    : upstream_(upstream),
+      max_block_(std::max(size_t(AMSTEL_ALIGNMENT),
+                          (max_block + AMSTEL_ALIGNMENT - 1) / AMSTEL_ALIGNMENT * AMSTEL_ALIGNMENT)),
+      slab_size_(std::max(slab_size, max_block_)),
+      free_lists_(max_block_ / AMSTEL_ALIGNMENT, 0)
+  {
+  }
+
+  inline
+  SlabPoolResource::~SlabPoolResource()
+  {
+    release();
+  }
+
+  inline
+  void
+  SlabPoolResource::release()
+  {
+    for (size_t i(0); i < slabs_.size(); i++)
+      upstream_->deallocate(slabs_[i], slab_size_, AMSTEL_ALIGNMENT);
+    slabs_.clear();
+    std::fill(free_lists_.begin(), free_lists_.end(), nullptr);
+  }
+
+  inline
+  int
+  SlabPoolResource::size_class(const size_t bytes, const size_t alignment) const
+  {
+    if (bytes > max_block_ || alignment > AMSTEL_ALIGNMENT)
+      return -1;
+    return bytes == 0 ? 0 : (bytes - 1) / AMSTEL_ALIGNMENT;
+  }
+
+  inline
+  void*
+  SlabPoolResource::do_allocate(size_t bytes, size_t alignment)
+  {
+    const int k(size_class(bytes, alignment));
+    if (k < 0)
+      return upstream_->allocate(bytes, alignment);
+
+    if (free_lists_[k] == nullptr)
+      {
+        // carve a new slab into blocks of the size class
+        char* slab(static_cast<char*>(upstream_->allocate(slab_size_, AMSTEL_ALIGNMENT)));
+        slabs_.push_back(slab);
+        const size_t block((k+1) * AMSTEL_ALIGNMENT);
+        for (size_t offset((slab_size_ / block - 1) * block); ; offset -= block)
+          {
+            FreeBlock* b(reinterpret_cast<FreeBlock*>(slab + offset));
+            b->next = free_lists_[k];
+            free_lists_[k] = b;
+            if (offset == 0)
+              break;
+          }
+      }
+
+    FreeBlock* b(free_lists_[k]);
+    free_lists_[k] = b->next;
+    return b;
+  }
+
+  inline
+  void
+  SlabPoolResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+  {
+    const int k(size_class(bytes, alignment));
+    if (k < 0)
+      {
+        upstream_->deallocate(p, bytes, alignment);
+        return;
+      }
+
+    FreeBlock* b(static_cast<FreeBlock*>(p));
+    b->next = free_lists_[k];
+    free_lists_[k] = b;
+  }
+
+  inline
+  bool
+  SlabPoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    return this == &other;
+  }
+}
@@ -0,0 +1,116 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_SLAB_POOL_H
+#define _AMSTEL_SLAB_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include <memory_resource>
+#include "utils/aligned_memory.h"
+
+namespace AMSTeL
+{
+  /*!
+    Memory resource for many small blocks of similar sizes, e.g., the storage of
+    millions of small Array1D objects (refinement masks, local value sets).
+    Requests of up to max_block bytes are rounded up to multiples of the
+    alignment unit AMSTEL_ALIGNMENT, and each of these size classes is served
+    from a free list, which is refilled by carving large slabs obtained from the
+    upstream resource. Allocation and deallocation are O(1), blocks of the same
+    size class are reused, and all blocks are aligned to AMSTEL_ALIGNMENT bytes.
+    Larger requests are forwarded to the upstream resource.
+    The memory of the slabs is returned to the upstream resource by release()
+    or by the destructor only.
+    Like std::pmr::unsynchronized_pool_resource, the class is not thread-safe;
+    use one pool per thread.
+  */
+  class SlabPoolResource
+    : public std::pmr::memory_resource
+  {
+  public:
+    /*!
+      constructor with the upstream resource, the largest block size served
+      from the pool and the size of the slabs (both in bytes)
+    */
+    explicit SlabPoolResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource(),
+                              const size_t max_block = 1024,
+                              const size_t slab_size = 64*1024);
+
+    /*!
+      release all slabs
+    */
+    ~SlabPoolResource();
+
+    /*!
+      return all slabs to the upstream resource,
+      invalidating all blocks allocated from the pool
+    */
+    void release();
+
+    /*!
+      upstream resource
+    */
+    inline std::pmr::memory_resource* upstream_resource() const { return upstream_; }
+
+    /*!
+      number of slabs obtained from the upstream resource
+    */
+    inline size_t slabs() const { return slabs_.size(); }
+
+    /*!
+      largest block size served from the pool
+    */
+    inline size_t max_block() const { return max_block_; }
+
+  protected:
+    /*!
+      memory_resource interface
+    */
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  private:
+    SlabPoolResource(const SlabPoolResource&) = delete;
+    SlabPoolResource& operator = (const SlabPoolResource&) = delete;
+
+    /*!
+      size class of a request, or -1 if it is forwarded to the upstream resource
+    */
+    int size_class(const size_t bytes, const size_t alignment) const;
+
+    /*!
+      entry of a free list (stored in the free block itself)
+    */
+    struct FreeBlock
+    {
+      FreeBlock* next;
+    };
+
+    std::pmr::memory_resource* upstream_;
+    size_t max_block_, slab_size_;
+
+    /*!
+      free lists for the size classes 1, 2, ... alignment units
+    */
+    std::vector<FreeBlock*> free_lists_;
+
+    /*!
+      slabs obtained from the upstream resource
+    */
+    std::vector<void*> slabs_;
+  };
+}
+
+#include "utils/slab_pool.cpp"
+
+#endif
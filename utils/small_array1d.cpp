@@ -0,0 +1,244 @@
+// implementation of some (inline) SmallArray1D<C,N>:: methods
+
+#include <cassert>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+#include "io/vector_io.h"
+
+namespace AMSTeL
+{
+  template <class C, unsigned int N>
+  inline
+  SmallArray1D<C,N>::SmallArray1D()
+    : data_(inline_data()), size_(0), capacity_(N)
+  {
+  }
+
+  template <class C, unsigned int N>
+  inline
+  SmallArray1D<C,N>::SmallArray1D(const size_type s)
+    : data_(inline_data()), size_(0), capacity_(N)
+  {
+    resize(s);
+  }
+
+  template <class C, unsigned int N>
+  inline
+  SmallArray1D<C,N>::SmallArray1D(const SmallArray1D<C,N>& a)
+    : data_(inline_data()), size_(0), capacity_(N)
+  {
+    reserve(a.size_);
+    std::uninitialized_copy(a.data_, a.data_+a.size_, data_);
+    size_ = a.size_;
+  }
+
+  template <class C, unsigned int N>
+  inline
+  SmallArray1D<C,N>::SmallArray1D(SmallArray1D<C,N>&& a) noexcept
+    : data_(inline_data()), size_(0), capacity_(N)
+  {
+    take_over(a);
+  }
+
+  template <class C, unsigned int N>
+  inline
+  SmallArray1D<C,N>::~SmallArray1D()
+  {
+    release();
+  }
+
+  template <class C, unsigned int N>
+  SmallArray1D<C,N>& SmallArray1D<C,N>::operator = (const SmallArray1D<C,N>& a)
+  {
+    if (this != &a)
+      {
+        clear();
+        reserve(a.size_);
+        std::uninitialized_copy(a.data_, a.data_+a.size_, data_);
+        size_ = a.size_;
+      }
+
+    return *this;
+  }
+
+  template <class C, unsigned int N>
+  inline
+  SmallArray1D<C,N>& SmallArray1D<C,N>::operator = (SmallArray1D<C,N>&& a) noexcept
+  {
+    if (this != &a)
+      {
+        release();
+        take_over(a);
+      }
+
+    return *this;
+  }
+
+  template <class C, unsigned int N>
+  void SmallArray1D<C,N>::take_over(SmallArray1D<C,N>& a) noexcept
+  {
+    if (a.is_inline())
+      {
+        std::uninitialized_move(a.data_, a.data_+a.size_, data_);
+        std::destroy_n(a.data_, a.size_);
+        size_ = a.size_;
+      }
+    else
+      {
+        data_ = a.data_;
+        size_ = a.size_;
+        capacity_ = a.capacity_;
+        a.data_ = a.inline_data();
+        a.capacity_ = N;
+      }
+    a.size_ = 0;
+  }
+
+  template <class C, unsigned int N>
+  inline
+  void SmallArray1D<C,N>::release()
+  {
+    std::destroy_n(data_, size_);
+    if (!is_inline())
+      deallocate_aligned(data_);
+    data_ = inline_data();
+    size_ = 0;
+    capacity_ = N;
+  }
+
+  template <class C, unsigned int N>
+  void SmallArray1D<C,N>::reallocate(const size_type s)
+  {
+    assert(s >= size_);
+
+    C* data = allocate_aligned<C>(s);
+    for (size_type i(0); i < size_; i++)
+      ::new (static_cast<void*>(data+i)) C(std::move_if_noexcept(data_[i]));
+    std::destroy_n(data_, size_);
+    if (!is_inline())
+      deallocate_aligned(data_);
+    data_ = data;
+    capacity_ = s;
+  }
+
+  template <class C, unsigned int N>
+  inline
+  void SmallArray1D<C,N>::reserve(const size_type s)
+  {
+    if (s > capacity_)
+      reallocate(s);
+  }
+
+  template <class C, unsigned int N>
+  void SmallArray1D<C,N>::resize(const size_type s)
+  {
+    if (s > size_)
+      {
+        if (s > capacity_)
+          reallocate(std::max(s, 2*capacity_));
+        std::uninitialized_value_construct(data_+size_, data_+s); // calls C()
+      }
+    else
+      std::destroy(data_+s, data_+size_);
+    size_ = s;
+  }
+
+  template <class C, unsigned int N>
+  inline
+  void SmallArray1D<C,N>::clear()
+  {
+    std::destroy_n(data_, size_);
+    size_ = 0;
+  }
+
+  template <class C, unsigned int N>
+  inline
+  void SmallArray1D<C,N>::push_back(const C& x)
+  {
+    emplace_back(x);
+  }
+
+  template <class C, unsigned int N>
+  inline
+  void SmallArray1D<C,N>::push_back(C&& x)
+  {
+    emplace_back(std::move(x));
+  }
+
+  template <class C, unsigned int N>
+  template <class... ARGS>
+  inline
+  C& SmallArray1D<C,N>::emplace_back(ARGS&&... args)
+  {
+    if (size_ == capacity_)
+      {
+        // the arguments may refer to old entries
+        C x(std::forward<ARGS>(args)...);
+        reallocate(2*capacity_);
+        ::new (static_cast<void*>(data_+size_)) C(std::move(x));
+      }
+    else
+      ::new (static_cast<void*>(data_+size_)) C(std::forward<ARGS>(args)...);
+    return data_[size_++];
+  }
+
+  template <class C, unsigned int N>
+  inline
+  const C& SmallArray1D<C,N>::operator [] (const size_type i) const
+  {
+    assert(i < size_);
+    return data_[i];
+  }
+
+  template <class C, unsigned int N>
+  inline
+  C& SmallArray1D<C,N>::operator [] (const size_type i)
+  {
+    assert(i < size_);
+    return data_[i];
+  }
+
+  template <class C, unsigned int N>
+  void SmallArray1D<C,N>::swap(SmallArray1D<C,N>& a) noexcept
+  {
+    if (!is_inline() && !a.is_inline())
+      {
+        std::swap(data_, a.data_);
+        std::swap(size_, a.size_);
+        std::swap(capacity_, a.capacity_);
+      }
+    else
+      {
+        SmallArray1D<C,N> help(std::move(a));
+        a = std::move(*this);
+        *this = std::move(help);
+      }
+  }
+
+  template <class C, unsigned int N>
+  void SmallArray1D<C,N>::swap (const size_type i, const size_type j)
+  {
+    assert(i < size_);
+    assert(j < size_);
+
+    std::swap(data_[i], data_[j]);
+  }
+
+  template <class C, unsigned int N>
+  inline
+  void swap(SmallArray1D<C,N>& a, SmallArray1D<C,N>& b) noexcept
+  {
+    a.swap(b);
+  }
+
+  template <class C, unsigned int N>
+  inline
+  std::ostream& operator << (std::ostream& os, const SmallArray1D<C,N>& a)
+  {
+    // use generic vector print routine
+    print_vector(a, os);
+    return os;
+  }
+}
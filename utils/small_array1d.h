@@ -0,0 +1,261 @@
+// -*- c++ -*-
+
+// +------------------------------------------------------------------------+
+// | This file is part of AMSTeL - the Adaptive MultiScale Template Library |
+// |                                                                        |
+// | Copyright (c) 2002-2023                                                |
+// | Thorsten Raasch, Manuel Werner, Jens Kappei, Dominik Lellek,           |
+// | Philipp Keding, Alexander Sieber, Henning Zickermann,                  |
+// | Ulrich Friedrich, Dorian Vogel, Carsten Weber, Simon Wardein           |
+// +------------------------------------------------------------------------+
+
+#ifndef _AMSTEL_SMALL_ARRAY1D_H
+#define _AMSTEL_SMALL_ARRAY1D_H
+
+#include <iostream>
+#include <cstddef>
+#include "utils/aligned_memory.h"
+
+namespace AMSTeL
+{
+  /*!
+    This class models one-dimensional arrays of objects from an arbitrary
+    class C, where the size is usually small but not known at compile time
+    (e.g., per-element value sets or index lists during assembly).
+    Up to N entries are stored within the object (small-buffer optimization),
+    so that no heap allocation happens at all; larger arrays switch to aligned
+    heap storage like Array1D<C>.
+    SmallArray1D<C,N> has the interface of Array1D<C>. Note that moving an
+    array with inline storage copies the entries.
+  */
+  template <class C, unsigned int N = 16>
+  class SmallArray1D
+  {
+  public:
+    /*!
+      value type (cf. STL containers)
+     */
+    typedef C value_type;
+
+    /*!
+      pointer type (cf. STL containers)
+     */
+    typedef value_type* pointer;
+
+    /*!
+      const pointer type (cf. STL containers)
+    */
+    typedef const value_type* const_pointer;
+
+    /*!
+      iterator type (cf. STL containers)
+    */
+    typedef value_type* iterator;
+
+    /*!
+      const iterator type (cf. STL containers)
+    */
+    typedef const value_type* const_iterator;
+
+    /*!
+      reference type (cf. STL containers)
+    */
+    typedef value_type& reference;
+    
+    /*!
+      const reference type (cf. STL containers)
+    */
+    typedef const value_type& const_reference;
+
+    /*!
+      type of indexes and size of the array
+     */
+    typedef size_t size_type;
+
+    /*!
+      default constructor, yields an empty array
+     */
+    SmallArray1D();
+
+    /*!
+      copy constructor
+    */
+    SmallArray1D(const SmallArray1D<C,N>& a);
+
+    /*!
+      move constructor, takes over the heap storage of a or moves
+      the inline entries, and leaves a empty
+    */
+    SmallArray1D(SmallArray1D<C,N>&& a) noexcept;
+
+    /*!
+      Construct an array of size s, the entries are value-initialized
+      (i.e., builtin types (int, double, ...) are set to zero).
+    */
+    explicit SmallArray1D(const size_type s);
+
+    /*!
+      release allocated memory
+    */
+    ~SmallArray1D();
+
+    /*!
+      assignment operator
+    */
+    SmallArray1D<C,N>& operator = (const SmallArray1D<C,N>& a);
+
+    /*!
+      move assignment, leaves a empty
+    */
+    SmallArray1D<C,N>& operator = (SmallArray1D<C,N>&& a) noexcept;
+
+    /*!
+      size of the array
+    */
+    size_type size() const { return size_; }
+
+    /*!
+      number of entries for which storage is available (at least N)
+    */
+    size_type capacity() const { return capacity_; }
+
+    /*!
+      true if the entries are stored within the object
+    */
+    bool is_inline() const { return data_ == inline_data(); }
+
+    /*!
+      Allocate storage for at least s entries, keeping the current entries.
+    */
+    void reserve(const size_type s);
+
+    /*!
+      Resize the array to length s, keeping the first min(s,size()) entries.
+      New entries are value-initialized (i.e., builtin types are set to zero).
+    */
+    void resize(const size_type s);
+
+    /*!
+      append an entry at the end of the array (amortized constant complexity)
+    */
+    void push_back(const C& x);
+
+    /*!
+      append an entry at the end of the array (amortized constant complexity)
+    */
+    void push_back(C&& x);
+
+    /*!
+      construct an entry in place at the end of the array
+      (amortized constant complexity)
+    */
+    template <class... ARGS>
+    C& emplace_back(ARGS&&... args);
+
+    /*!
+      remove all entries, keeping the storage
+    */
+    void clear();
+
+    /*!
+      read-only access to the i-th array member
+    */
+    const C& operator [] (const size_type i) const;
+
+    /*!
+      read-write access to the i-th array member
+    */
+    C& operator [] (const size_type i);
+
+    /*!
+      read-only iterator access to first element (cf. STL containers)
+    */
+    const_iterator begin() const { return data_; }
+
+    /*!
+      read-write iterator access to first element (cf. STL containers)
+    */
+    iterator begin() { return data_; }
+
+    /*!
+      read-only iterator access to the element behind the last one
+      (cf. STL containers)
+    */
+    const_iterator end() const { return data_+size_; }
+
+    /*!
+      read-write iterator access to the element behind the last one
+      (cf. STL containers)
+    */
+    iterator end() { return data_+size_; }
+
+    /*!
+      swap the contents of two arrays
+    */
+    void swap (SmallArray1D<C,N>& a) noexcept;
+
+    /*!
+      swap two entries of an array
+    */
+    void swap (const size_type i, const size_type j);
+
+  protected:
+    /*!
+      inline storage
+    */
+    const C* inline_data() const { return reinterpret_cast<const C*>(buffer_); }
+    C* inline_data() { return reinterpret_cast<C*>(buffer_); }
+
+    /*!
+      move the entries into new storage for s >= size() entries
+    */
+    void reallocate(const size_type s);
+
+    /*!
+      move the entries of a into the empty array (*this), leaving a empty
+    */
+    void take_over(SmallArray1D<C,N>& a) noexcept;
+
+    /*!
+      destroy the entries and release the heap storage, if any
+    */
+    void release();
+
+    /*!
+      pointer to the entries (either to the inline buffer or to heap storage)
+    */
+    C* data_;
+
+    /*!
+      size of the array
+    */
+    size_type size_;
+
+    /*!
+      number of entries for which storage is available
+    */
+    size_type capacity_;
+
+    /*!
+      inline storage for up to N entries
+    */
+    alignas(C) unsigned char buffer_[N*sizeof(C)];
+  };
+
+  /*!
+    swap the contents of two arrays
+  */
+  template <class C, unsigned int N>
+  void swap(SmallArray1D<C,N>& a, SmallArray1D<C,N>& b) noexcept;
+
+  /*!
+    Matlab-style stream output for arrays
+   */
+  template <class C, unsigned int N>
+  std::ostream& operator << (std::ostream& os, const SmallArray1D<C,N>& a);
+}
+
+// include implementation of inline functions
+#include "utils/small_array1d.cpp"
+
+#endif